@@ -0,0 +1,240 @@
+/*
+ * File:   Benchmark.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "Benchmark.h"
+
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+
+static std::string escapeJSON( const std::string& text )
+{
+    std::string escaped;
+
+    for( char c : text )
+    {
+        if( c == '"' || c == '\\' )
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if( ( unsigned char )c < 0x20 )
+        {
+            char code[ 8 ];
+            snprintf( code, sizeof( code ), "\\u%04x", c );
+            escaped += code;
+        }
+        else
+            escaped += c;
+    }
+
+    return escaped;
+}
+
+double Benchmark::Result::getMinimum() const
+{
+    return seconds.empty() ? 0. : *std::min_element( seconds.begin(), seconds.end() );
+}
+
+double Benchmark::Result::getMedian() const
+{
+    return getPercentile( 50. );
+}
+
+double Benchmark::Result::getPercentile( double percent ) const
+{
+    if( seconds.empty() )
+        return 0.;
+
+    std::vector< double > sorted( seconds );
+    std::sort( sorted.begin(), sorted.end() );
+
+    double position = std::min( std::max( percent, 0. ), 100. ) / 100. * ( sorted.size() - 1 );
+    size_t below = ( size_t )position;
+
+    if( below + 1 >= sorted.size() )
+        return sorted.back();
+
+    return sorted[ below ] + ( position - below ) * ( sorted[ below + 1 ] - sorted[ below ] );
+}
+
+Benchmark::Benchmark( unsigned int repetitions ) :
+    _repetitions( std::max( repetitions, 1u ) )
+{
+}
+
+Benchmark::Result Benchmark::run( const std::string& name, const std::function< void () >& function, size_t bytes )
+{
+    Result result;
+    result.name = name;
+
+    for( unsigned int i = 0; i < _repetitions; i++ )
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        auto stop = std::chrono::steady_clock::now();
+
+        result.seconds.push_back( std::chrono::duration< double >( stop - start ).count() );
+    }
+
+    double median = result.getMedian();
+
+    if( bytes )
+    {
+        printf( "%-40s min %9.3f ms  median %9.3f ms  p90 %9.3f ms  %8.1f MB/s\n", name.c_str(),
+                1e3 * result.getMinimum(), 1e3 * median, 1e3 * result.getPercentile( 90. ),
+                bytes / median / ( 1024. * 1024. ) );
+    }
+    else
+    {
+        printf( "%-40s min %9.3f ms  median %9.3f ms  p90 %9.3f ms\n", name.c_str(),
+                1e3 * result.getMinimum(), 1e3 * median, 1e3 * result.getPercentile( 90. ) );
+    }
+
+    _results.push_back( result );
+
+    return result;
+}
+
+unsigned int Benchmark::getRepetitions() const
+{
+    return _repetitions;
+}
+
+void Benchmark::setRepetitions( unsigned int repetitions )
+{
+    _repetitions = std::max( repetitions, 1u );
+}
+
+const std::vector< Benchmark::Result >& Benchmark::getResults() const
+{
+    return _results;
+}
+
+bool Benchmark::writeJSON( const std::string& filename ) const
+{
+    std::ofstream out( filename.c_str(), std::ios::trunc );
+
+    if( !out )
+        return false;
+
+    out.precision( 6 );
+    out << "{\n  \"results\": [\n";
+
+    // One case by line, so readJSON and line based tools can scan it
+    for( size_t i = 0; i < _results.size(); i++ )
+    {
+        const Result& result = _results[ i ];
+
+        out << "    { \"name\": \"" << escapeJSON( result.name ) << "\", \"runs\": " << result.seconds.size()
+            << ", \"min_ms\": " << 1e3 * result.getMinimum()
+            << ", \"median_ms\": " << 1e3 * result.getMedian()
+            << ", \"p90_ms\": " << 1e3 * result.getPercentile( 90. )
+            << ", \"p99_ms\": " << 1e3 * result.getPercentile( 99. )
+            << ", \"max_ms\": " << 1e3 * result.getPercentile( 100. ) << ", \"times_ms\": [";
+
+        for( size_t run = 0; run < result.seconds.size(); run++ )
+            out << ( run ? ", " : " " ) << 1e3 * result.seconds[ run ];
+
+        out << " ] }" << ( i + 1 < _results.size() ? "," : "" ) << "\n";
+    }
+
+    out << "  ]\n}\n";
+
+    return ( bool )out;
+}
+
+bool Benchmark::readJSON( const std::string& filename, std::vector< Result >& results )
+{
+    std::ifstream in( filename.c_str() );
+
+    if( !in )
+        return false;
+
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    const std::string nameKey = "\"name\": \"";
+    const std::string timesKey = "\"times_ms\": [";
+    size_t position = 0;
+
+    results.clear();
+
+    while( ( position = text.find( nameKey, position ) ) != std::string::npos )
+    {
+        Result result;
+        position += nameKey.size();
+
+        for( ; position < text.size() && text[ position ] != '"'; position++ )
+        {
+            if( text[ position ] == '\\' && position + 1 < text.size() )
+                position++;
+
+            result.name += text[ position ];
+        }
+
+        position = text.find( timesKey, position );
+
+        if( position == std::string::npos )
+            return false;
+
+        const char* cursor = text.c_str() + position + timesKey.size();
+        char* end;
+
+        for( double time = strtod( cursor, &end ); end != cursor; time = strtod( cursor, &end ) )
+        {
+            result.seconds.push_back( 1e-3 * time );
+            cursor = end;
+
+            while( *cursor == ',' || *cursor == ' ' )
+                cursor++;
+        }
+
+        results.push_back( result );
+    }
+
+    return true;
+}
+
+size_t Benchmark::compare( const std::vector< Result >& baseline, double tolerance ) const
+{
+    size_t numberRegressions = 0, numberCompared = 0;
+
+    printf( "\nComparison against the baseline (tolerance %.0f%%)\n", 100 * tolerance );
+
+    for( const Result& result : _results )
+    {
+        auto saved = std::find_if( baseline.begin(), baseline.end(), [ & ]( const Result& r )
+        {
+            return r.name == result.name;
+        } );
+
+        if( saved == baseline.end() || saved->getMinimum() <= 0 )
+            continue;
+
+        double change = result.getMedian() / saved->getMedian() - 1;
+        double minimumChange = result.getMinimum() / saved->getMinimum() - 1;
+
+        numberCompared++;
+
+        if( change > tolerance && minimumChange > tolerance )
+            numberRegressions++;
+        else if( change >= -tolerance || minimumChange >= -tolerance )
+            continue;
+
+        printf( "%-7s %-40s median %9.3f ms  baseline %9.3f ms  %+6.1f%%  min %+6.1f%%\n",
+                ( change > 0 ) ? "SLOWER" : "faster", result.name.c_str(), 1e3 * result.getMedian(),
+                1e3 * saved->getMedian(), 100 * change, 100 * minimumChange );
+    }
+
+    printf( "%zu cases compared, %zu slower\n", numberCompared, numberRegressions );
+
+    return numberRegressions;
+}
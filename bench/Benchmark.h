@@ -0,0 +1,102 @@
+/*
+ * File:   Benchmark.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <functional>
+
+/**@class Benchmark
+ * Minimal timing harness. Each case is run a number of times and the wall
+ * time of every run is kept to report the best, the median and the 90th
+ * percentile. The results of all the cases are kept, to be saved as JSON and
+ * compared against a saved baseline.
+ */
+class Benchmark
+{
+public:
+
+    struct Result
+    {
+        std::string name;
+        std::vector< double > seconds;
+
+        double getMinimum() const;
+        double getMedian() const;
+
+        /**
+         * Return a percentile of the timings, interpolated between the two
+         * closest runs.
+         * @param percent - percentile, from 0 to 100.
+         * @return - time in seconds.
+         */
+        double getPercentile( double percent ) const;
+    };
+
+    Benchmark( unsigned int repetitions );
+
+    /**
+     * Run a case and print its timings.
+     * @param name - case name.
+     * @param function - code to be timed.
+     * @param bytes - amount of data processed by one run, used to report
+     * throughput. Zero disables the throughput column.
+     * @return - the collected timings.
+     */
+    Result run( const std::string& name, const std::function< void () >& function, size_t bytes = 0 );
+
+    unsigned int getRepetitions() const;
+
+    /**
+     * Change the number of runs of the next cases, for the cases too slow to
+     * be run many times.
+     * @param repetitions - number of runs, at least one.
+     */
+    void setRepetitions( unsigned int repetitions );
+
+    /**
+     * Return the results of all the cases run so far.
+     * @return - results, in the order they were run.
+     */
+    const std::vector< Result >& getResults() const;
+
+    /**
+     * Write the results as a JSON file: the statistics of each case, in
+     * milliseconds, and its runs.
+     * @param filename - path of the file.
+     * @return - true if the file was written.
+     */
+    bool writeJSON( const std::string& filename ) const;
+
+    /**
+     * Read the runs of each case of a file written by writeJSON.
+     * @param filename - path of the file.
+     * @param results - filled with the results, in the order of the file.
+     * @return - false if the file could not be read.
+     */
+    static bool readJSON( const std::string& filename, std::vector< Result >& results );
+
+    /**
+     * Compare the results against a baseline and print the cases that got
+     * slower or faster by more than the tolerance. A case is only counted as
+     * slower if both its best and its median time are, so a few runs slowed
+     * down by the machine do not flag it.
+     * @param baseline - results of a previous run, as read by readJSON.
+     * @param tolerance - relative change that is not reported, as 0.1 for 10%.
+     * @return - number of cases slower than the tolerance allows.
+     */
+    size_t compare( const std::vector< Result >& baseline, double tolerance ) const;
+
+private:
+
+    unsigned int _repetitions;
+
+    std::vector< Result > _results;
+};
+
+#endif /* BENCHMARK_H */
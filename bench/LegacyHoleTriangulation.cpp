@@ -0,0 +1,253 @@
+/*
+ * File:   LegacyHoleTriangulation.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "LegacyHoleTriangulation.h"
+
+#include <map>
+#include <tuple>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+typedef HoleTriangulator::DihedralAngleWeight DihedralAngleWeight;
+
+struct Vector
+{
+    Vector( double x, double y, double z ) : x( x ), y( y ), z( z ) {}
+
+    Vector operator-( const Vector& v ) const { return Vector( x - v.x, y - v.y, z - v.z ); }
+
+    Vector operator^( const Vector& v ) const { return Vector( y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x ); }
+
+    double operator*( const Vector& v ) const { return x * v.x + y * v.y + z * v.z; }
+
+    double length() const { return sqrt( x * x + y * y + z * z ); }
+
+    double x, y, z;
+};
+
+static Vector position( const CornerTable& cornerTable, CornerType vertex )
+{
+    return Vector( cornerTable.getAttributes()[ 3 * vertex ], cornerTable.getAttributes()[ 3 * vertex + 1 ],
+                   cornerTable.getAttributes()[ 3 * vertex + 2 ] );
+}
+
+static double calculateDihedralAngle( const CornerTable& cornerTable, CornerType vi, CornerType vj, CornerType vk,
+                                      CornerType vl, CornerType vm, CornerType vn )
+{
+    Vector normal1 = ( position( cornerTable, vj ) - position( cornerTable, vi ) ) ^
+                     ( position( cornerTable, vk ) - position( cornerTable, vi ) );
+    Vector normal2 = ( position( cornerTable, vm ) - position( cornerTable, vl ) ) ^
+                     ( position( cornerTable, vn ) - position( cornerTable, vl ) );
+
+    return std::acos( normal1 * normal2 );
+}
+
+HoleBoundary legacyMinimumPatchMesh( std::shared_ptr< CornerTable > cornerTable, const HoleBoundary& boundary,
+                                     DihedralAngleWeight& weight )
+{
+    std::map< std::tuple< CornerType, CornerType >, std::tuple< CornerType, DihedralAngleWeight > > weightSet;
+
+    CornerType n = ( CornerType )boundary.size();
+    const CornerTable& mesh = *cornerTable;
+
+    auto findCommonTriangle = [ & ]( std::vector< CornerType > n1, std::vector< CornerType > n2 )
+    {
+        for( auto c1 : n1 )
+        {
+            for( auto c2 : n2 )
+            {
+                if( mesh.cornerTriangle( c1 ) == mesh.cornerTriangle( c2 ) )
+                    return mesh.cornerTriangle( c1 );
+            }
+        }
+
+        return CornerTable::BORDER_CORNER;
+    };
+
+    // Angle against the mesh triangle across a boundary edge. The vertices of
+    // the triangle are read from the V table (the original used its corners).
+    auto meshTriangleAngle = [ & ]( CornerType vi, CornerType vj, CornerType vk, CornerType a, CornerType b,
+                                    bool& hasAngle )
+    {
+        CornerType t = findCommonTriangle( mesh.getCornerNeighbours( mesh.vertexToCornerIndex( boundary[ a ] ) ),
+                                           mesh.getCornerNeighbours( mesh.vertexToCornerIndex( boundary[ b ] ) ) );
+        hasAngle = t != CornerTable::BORDER_CORNER;
+
+        if( !hasAngle )
+            return 0.;
+
+        return calculateDihedralAngle( mesh, boundary[ vi ], boundary[ vj ], boundary[ vk ],
+                                       mesh.cornerToVertexIndex( 3 * t ), mesh.cornerToVertexIndex( 3 * t + 1 ),
+                                       mesh.cornerToVertexIndex( 3 * t + 2 ) );
+    };
+
+    auto weightFunction = [ & ]( CornerType vi, CornerType vj, CornerType vk )
+    {
+        Vector v1 = position( mesh, boundary[ vi ] );
+        Vector v2 = position( mesh, boundary[ vj ] );
+        Vector v3 = position( mesh, boundary[ vk ] );
+
+        double a = ( v2 - v1 ).length();
+        double b = ( v2 - v3 ).length();
+        double c = ( v3 - v1 ).length();
+
+        double area = 0.5 * a * b * sin( c );
+        double angle = 0;
+        bool hasAngle = false;
+
+        auto addAngle = [ & ]( double sideAngle, bool hasSideAngle )
+        {
+            if( !hasSideAngle )
+                return;
+
+            angle = hasAngle ? DihedralAngleWeight::maximumAngle( angle, sideAngle ) : sideAngle;
+            hasAngle = true;
+        };
+
+        // Pairs of consecutive vertices face the mesh (the original read a
+        // split of -1 there)
+        auto addSide = [ & ]( CornerType va, CornerType vb )
+        {
+            bool hasSideAngle;
+
+            if( vb == va + 1 )
+            {
+                double sideAngle = meshTriangleAngle( vi, vj, vk, va, vb, hasSideAngle );
+                addAngle( sideAngle, hasSideAngle );
+                return;
+            }
+
+            CornerType s = std::get< 0 >( weightSet[ std::make_tuple( va, vb ) ] );
+            addAngle( calculateDihedralAngle( mesh, boundary[ vi ], boundary[ vj ], boundary[ vk ],
+                                              boundary[ va ], boundary[ s ], boundary[ vb ] ), true );
+        };
+
+        addSide( vi, vj );
+        addSide( vj, vk );
+
+        if( vi == 0 && vk == n - 1 && !( vj == vi + 1 && vk == vj + 1 ) )
+        {
+            bool hasSideAngle;
+            double sideAngle = meshTriangleAngle( vi, vj, vk, 0, n - 1, hasSideAngle );
+            addAngle( sideAngle, hasSideAngle );
+        }
+
+        return DihedralAngleWeight( angle, area );
+    };
+
+    for( CornerType i = 0; i <= n - 2; i++ )
+        weightSet[ std::make_tuple( i, i + 1 ) ] = std::make_tuple( -1, DihedralAngleWeight() );
+
+    for( CornerType i = 0; i <= n - 3; i++ )
+        weightSet[ std::make_tuple( i, i + 2 ) ] = std::make_tuple( i + 1, weightFunction( i, i + 1, i + 2 ) );
+
+    CornerType j = 2;
+
+    while( j < n - 1 )
+    {
+        j++;
+
+        for( CornerType i = 0; i <= n - j - 1; i++ )
+        {
+            CornerType k = i + j;
+            int minIndex = -1;
+            DihedralAngleWeight minWeight( M_PI, DBL_MAX );
+
+            for( CornerType m = i + 1; m <= k - 1; m++ )
+            {
+                DihedralAngleWeight wim = std::get< 1 >( weightSet[ std::make_tuple( i, m ) ] );
+                DihedralAngleWeight wmk = std::get< 1 >( weightSet[ std::make_tuple( m, k ) ] );
+                DihedralAngleWeight f = weightFunction( i, m, k );
+                DihedralAngleWeight total = wim + wmk + f;
+
+                if( total < minWeight )
+                {
+                    minWeight = total;
+                    minIndex = m;
+                }
+            }
+
+            weightSet[ std::make_tuple( i, k ) ] = std::make_tuple( minIndex, minWeight );
+        }
+    }
+
+    std::vector< CornerType > indexes;
+
+    std::function< void ( CornerType, CornerType ) > trace = [ & ]( CornerType i, CornerType k )
+    {
+        if( i + 2 == k )
+        {
+            indexes.push_back( i );
+            indexes.push_back( i + 1 );
+            indexes.push_back( k );
+        }
+        else
+        {
+            CornerType o = std::get< 0 >( weightSet[ std::make_tuple( i, k ) ] );
+
+            if( o != i + 1 )
+                trace( i, o );
+
+            indexes.push_back( i );
+            indexes.push_back( o );
+            indexes.push_back( k );
+
+            if( o != k - 1 )
+                trace( o, k );
+        }
+    };
+
+    weight = DihedralAngleWeight();
+
+    if( n < 3 )
+        return indexes;
+
+    trace( 0, n - 1 );
+    weight = std::get< 1 >( weightSet[ std::make_tuple( 0, n - 1 ) ] );
+
+    return indexes;
+}
+
+std::vector< HoleBoundary > extractHoleBoundaries( const CornerTable& cornerTable )
+{
+    std::map< CornerType, CornerType > boundaryEdges;
+
+    for( CornerType corner = 0; corner < 3 * cornerTable.getNumTriangles(); corner++ )
+    {
+        if( cornerTable.cornerOpposite( corner ) == CornerTable::BORDER_CORNER )
+            boundaryEdges[ cornerTable.cornerToVertexIndex( cornerTable.cornerNext( corner ) ) ] =
+                cornerTable.cornerToVertexIndex( cornerTable.cornerPrevious( corner ) );
+    }
+
+    std::vector< HoleBoundary > boundaries;
+
+    while( !boundaryEdges.empty() )
+    {
+        auto oldIt = boundaryEdges.begin();
+        auto currentIt = boundaryEdges.find( oldIt->second );
+
+        HoleBoundary hole = { oldIt->first };
+
+        while( currentIt != boundaryEdges.end() )
+        {
+            hole.push_back( currentIt->first );
+            boundaryEdges.erase( oldIt );
+
+            oldIt = currentIt;
+            currentIt = boundaryEdges.find( oldIt->second );
+        }
+
+        boundaryEdges.erase( oldIt );
+
+        std::reverse( hole.begin(), hole.end() );
+
+        boundaries.push_back( hole );
+    }
+
+    return boundaries;
+}
@@ -0,0 +1,35 @@
+/*
+ * File:   LegacyHoleTriangulation.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef LEGACYHOLETRIANGULATION_H
+#define LEGACYHOLETRIANGULATION_H
+
+#include "../src/HoleTriangulator.h"
+#include <vector>
+#include <memory>
+
+/**
+ * Reference copy of the std::map based dynamic programming that
+ * MeshCompletionApplication::calculateMinimumPatchMesh used before
+ * HoleTriangulator, without the osg types. It is kept for comparison only.
+ * @param cornerTable - mesh with the hole.
+ * @param boundary - vertices of the hole.
+ * @param weight - filled with the weight of the triangulation.
+ * @return - triangles as triples of positions on the boundary.
+ */
+HoleBoundary legacyMinimumPatchMesh( std::shared_ptr< CornerTable > cornerTable, const HoleBoundary& boundary,
+                                     HoleTriangulator::DihedralAngleWeight& weight );
+
+/**
+ * Hole boundaries of a mesh, in the order of
+ * MeshCompletionApplication::calculateHoleBoundaries.
+ * @param cornerTable - mesh.
+ * @return - one list of vertices by hole.
+ */
+std::vector< HoleBoundary > extractHoleBoundaries( const CornerTable& cornerTable );
+
+#endif /* LEGACYHOLETRIANGULATION_H */
+
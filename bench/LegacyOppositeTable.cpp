@@ -0,0 +1,63 @@
+/*
+ * File:   LegacyOppositeTable.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "LegacyOppositeTable.h"
+
+#include <list>
+
+static inline CornerType cornerNext( const CornerType corner )
+{
+    return 3 * ( corner / 3 ) + ( corner + 1 ) % 3;
+}
+
+static inline CornerType cornerPrevious( const CornerType corner )
+{
+    return 3 * ( corner / 3 ) + ( corner + 2 ) % 3;
+}
+
+void buildLegacyOppositeTable( const CornerType* triangleList, CornerType numberTriangles, CornerType numberVertices,
+                               std::vector< CornerType >& oppositeCorner, std::vector< CornerType >& vertexToCorner )
+{
+    oppositeCorner.assign( 3 * numberTriangles, CornerTable::BORDER_CORNER );
+    vertexToCorner.assign( numberVertices, 0 );
+
+    std::vector< std::list< CornerType > > cornersInVertices( numberVertices );
+
+    for( CornerType corner = 0; corner < 3 * numberTriangles; corner++ )
+    {
+        CornerType vertex = triangleList[ corner ];
+        cornersInVertices[ vertex ].push_back( corner );
+        vertexToCorner[ vertex ] = corner;
+    }
+
+    for( CornerType corner = 0; corner < 3 * numberTriangles; corner++ )
+    {
+        if( oppositeCorner[ corner ] != CornerTable::BORDER_CORNER )
+            continue;
+
+        CornerType vertexNext = triangleList[ cornerNext( corner ) ];
+        CornerType vertexPrevious = triangleList[ cornerPrevious( corner ) ];
+        CornerType opposite = CornerTable::BORDER_CORNER;
+
+        for( CornerType cornerOfVertexPrevious : cornersInVertices[ vertexPrevious ] )
+        {
+            if( triangleList[ cornerNext( cornerOfVertexPrevious ) ] == vertexNext )
+            {
+                opposite = cornerPrevious( cornerOfVertexPrevious );
+                break;
+            }
+        }
+
+        if( opposite == CornerTable::BORDER_CORNER )
+        {
+            vertexToCorner[ vertexNext ] = cornerNext( corner );
+            continue;
+        }
+
+        oppositeCorner[ corner ] = opposite;
+        oppositeCorner[ opposite ] = corner;
+    }
+}
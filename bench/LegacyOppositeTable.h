@@ -0,0 +1,26 @@
+/*
+ * File:   LegacyOppositeTable.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef LEGACYOPPOSITETABLE_H
+#define LEGACYOPPOSITETABLE_H
+
+#include "../src/CornerTable.h"
+#include <vector>
+
+/**
+ * Reference copy of the list based construction of the opposite table that
+ * CornerTable used before the edge hash. It is kept for comparison only.
+ * @param triangleList - the oriented triangle list.
+ * @param numberTriangles - number of triangles.
+ * @param numberVertices - number of vertices.
+ * @param oppositeCorner - filled with the opposite of each corner.
+ * @param vertexToCorner - filled with a corner of each vertex.
+ */
+void buildLegacyOppositeTable( const CornerType* triangleList, CornerType numberTriangles, CornerType numberVertices,
+                               std::vector< CornerType >& oppositeCorner, std::vector< CornerType >& vertexToCorner );
+
+#endif /* LEGACYOPPOSITETABLE_H */
+
@@ -0,0 +1,1282 @@
+/*
+ * File:   main.cpp
+ *
+ * Created on October 16, 2026
+ *
+ * Performance harness. Run it from the repository root so the bundled meshes
+ * in data/ are found:
+ *
+ *     bin/mcbench [repetitions] [maximum hole size] [--json results.json]
+ *                 [--baseline baseline.json] [--tolerance 0.1]
+ *
+ * --json saves the timings of every case. --baseline compares them against a
+ * file saved by --json and exits with 1 if a case got slower than the
+ * tolerance allows.
+ */
+
+#include "Benchmark.h"
+#include "LegacyOppositeTable.h"
+#include "LegacyHoleTriangulation.h"
+#include "../src/OFFMeshLoader.h"
+#include "../src/MeshCache.h"
+#include "../src/GeometryKernels.h"
+#include "../src/PatchRefiner.h"
+#include "../src/HoleFiller.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sys/stat.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static size_t fileSize( const std::string& fileName )
+{
+    struct stat status;
+
+    return stat( fileName.c_str(), &status ) == 0 ? ( size_t )status.st_size : 0;
+}
+
+static bool isSameMesh( const CornerTable& a, const CornerTable& b )
+{
+    if( a.getNumberVertices() != b.getNumberVertices() || a.getNumTriangles() != b.getNumTriangles() )
+        return false;
+
+    return !memcmp( a.getAttributes(), b.getAttributes(), 3 * a.getNumberVertices() * sizeof( double ) ) &&
+           !memcmp( a.getTriangleList(), b.getTriangleList(), 3 * a.getNumTriangles() * sizeof( CornerType ) );
+}
+
+static void benchmarkLoader( Benchmark& benchmark, const std::string& fileName )
+{
+    size_t bytes = fileSize( fileName );
+
+    if( !bytes )
+    {
+        printf( "%s not found, skipped\n", fileName.c_str() );
+        return;
+    }
+
+    OFFMeshLoader loader;
+    loader.setCacheEnabled( false );
+
+    benchmark.run( "parse " + fileName, [ & ]()
+    {
+        loader.parse( fileName );
+    }, bytes );
+}
+
+static void benchmarkCachedLoader( Benchmark& benchmark, const std::string& fileName )
+{
+    size_t bytes = fileSize( fileName );
+
+    if( !bytes )
+        return;
+
+    // The first load writes the sidecar cache
+    OFFMeshLoader loader;
+    loader.setCacheEnabled( true );
+    auto parsedMesh = loader.parse( fileName );
+    auto cachedMesh = loader.parse( fileName );
+
+    if( !isSameMesh( *parsedMesh, *cachedMesh ) )
+        printf( "    cached mesh differs from the parsed one\n" );
+
+    benchmark.run( "reload " + fileName + " from cache", [ & ]()
+    {
+        loader.parse( fileName );
+    }, fileSize( MeshCache::getCacheFilename( fileName ) ) );
+
+    std::remove( MeshCache::getCacheFilename( fileName ).c_str() );
+}
+
+static void benchmarkParallelLoader( Benchmark& benchmark, const std::string& fileName )
+{
+    size_t bytes = fileSize( fileName );
+
+    if( !bytes )
+        return;
+
+    OFFMeshLoader serialLoader;
+    serialLoader.setCacheEnabled( false );
+    serialLoader.setParseMode( OFFMeshLoader::SERIAL );
+    auto serialMesh = serialLoader.parse( fileName );
+
+    int maximumThreads = 1;
+
+#ifdef _OPENMP
+    maximumThreads = omp_get_max_threads();
+#endif
+
+    // 1, 2, 4, ... up to all the cores
+    std::vector< int > threadCounts;
+
+    for( int nThreads = 1; nThreads < maximumThreads; nThreads *= 2 )
+        threadCounts.push_back( nThreads );
+
+    threadCounts.push_back( maximumThreads );
+
+    for( int nThreads : threadCounts )
+    {
+        OFFMeshLoader loader;
+        loader.setCacheEnabled( false );
+        loader.setParseMode( OFFMeshLoader::PARALLEL );
+        loader.setNumberThreads( nThreads );
+
+        benchmark.run( "parse " + fileName + " threads=" + std::to_string( nThreads ), [ & ]()
+        {
+            loader.parse( fileName );
+        }, bytes );
+
+        if( !isSameMesh( *serialMesh, *loader.parse( fileName ) ) )
+            printf( "    result differs from the serial parser\n" );
+    }
+}
+
+static void benchmarkOppositeTable( Benchmark& benchmark, const std::string& fileName )
+{
+    auto mesh = OFFMeshLoader().parse( fileName );
+
+    if( !mesh )
+        return;
+
+    const CornerType* triangles = mesh->getTriangleList();
+    CornerType nTriangles = mesh->getNumTriangles();
+    CornerType nVertices = mesh->getNumberVertices();
+
+    std::vector< CornerType > oppositeCorner, vertexToCorner;
+
+    benchmark.run( "opposite table (lists) " + fileName, [ & ]()
+    {
+        buildLegacyOppositeTable( triangles, nTriangles, nVertices, oppositeCorner, vertexToCorner );
+    } );
+
+    CornerTable::setParallelBuildThreshold( 3 * nTriangles + 1 );
+
+    benchmark.run( "opposite table (hash) " + fileName, [ & ]()
+    {
+        CornerTable( triangles, mesh->getAttributes(), nTriangles, nVertices, 3 );
+    } );
+
+    CornerTable cornerTable( triangles, mesh->getAttributes(), nTriangles, nVertices, 3 );
+
+    if( memcmp( cornerTable.getOppositeList(), oppositeCorner.data(), 3 * nTriangles * sizeof( CornerType ) ) ||
+        memcmp( cornerTable.getVertexToCornerList(), vertexToCorner.data(), nVertices * sizeof( CornerType ) ) )
+        printf( "    tables differ from the list based construction\n" );
+
+#ifdef _OPENMP
+    // The sort based builder is only used with more than one thread
+    CornerTable::setParallelBuildThreshold( 0 );
+
+    int maximumThreads = omp_get_max_threads();
+
+    for( int nThreads = 2; nThreads <= std::max( 2, maximumThreads ); nThreads *= 2 )
+    {
+        omp_set_num_threads( nThreads );
+
+        benchmark.run( "opposite table (sort) " + fileName + " threads=" + std::to_string( nThreads ), [ & ]()
+        {
+            CornerTable( triangles, mesh->getAttributes(), nTriangles, nVertices, 3 );
+        } );
+
+        CornerTable sortedCornerTable( triangles, mesh->getAttributes(), nTriangles, nVertices, 3 );
+
+        if( memcmp( cornerTable.getOppositeList(), sortedCornerTable.getOppositeList(),
+                    3 * nTriangles * sizeof( CornerType ) ) ||
+            memcmp( cornerTable.getVertexToCornerList(), sortedCornerTable.getVertexToCornerList(),
+                    nVertices * sizeof( CornerType ) ) ||
+            cornerTable.getNonManifoldCorners() != sortedCornerTable.getNonManifoldCorners() )
+            printf( "    tables differ from the hash based construction\n" );
+
+        if( nThreads >= maximumThreads )
+            break;
+    }
+
+    omp_set_num_threads( maximumThreads );
+#endif
+
+    CornerTable::setParallelBuildThreshold( 1 << 20 );
+}
+
+template< class Storage >
+static void benchmarkEdgeLengths( Benchmark& benchmark, const std::string& name, const CornerTable& mesh )
+{
+    CornerTableT< Storage > cornerTable( mesh.getTriangleList(), mesh.getAttributes(), mesh.getNumTriangles(),
+                                         mesh.getNumberVertices(), 3 );
+    size_t bytes = 3 * ( size_t )mesh.getNumberVertices() * sizeof( typename Storage::ScalarType );
+    double total = 0;
+
+    benchmark.run( "edge lengths (" + name + ", " + std::to_string( bytes / 1024 ) + " KB)", [ & ]()
+    {
+        total = 0;
+
+        for( CornerType corner = 0; corner < 3 * cornerTable.getNumTriangles(); corner++ )
+            total += cornerTable.edgeLength( corner );
+    } );
+
+    printf( "    total %.6f\n", total );
+}
+
+static void benchmarkVertexStorage( Benchmark& benchmark, const std::string& fileName )
+{
+    auto mesh = OFFMeshLoader().parse( fileName );
+
+    if( !mesh )
+        return;
+
+    benchmarkEdgeLengths< InterleavedStorage< double > >( benchmark, "interleaved double " + fileName, *mesh );
+    benchmarkEdgeLengths< PlanarStorage< double > >( benchmark, "planar double " + fileName, *mesh );
+    benchmarkEdgeLengths< PlanarStorage< float > >( benchmark, "planar float " + fileName, *mesh );
+}
+
+static void benchmarkGeometryKernels( Benchmark& benchmark, const std::string& fileName )
+{
+    auto mesh = OFFMeshLoader().parse( fileName );
+
+    if( !mesh )
+        return;
+
+    CornerType nCorners = 3 * mesh->getNumTriangles();
+    CornerType nVertices = mesh->getNumberVertices();
+    std::vector< double > edgeLengths, averages, areas, normals, scalarAreas, scalarNormals;
+
+    std::vector< double > expectedLengths( nCorners ), expectedAverages( nVertices );
+
+    benchmark.run( "edge lengths (per call) " + fileName, [ & ]()
+    {
+        for( CornerType corner = 0; corner < nCorners; corner++ )
+            expectedLengths[ corner ] = mesh->edgeLength( corner );
+    } );
+
+    benchmark.run( "average edge lengths (per call) " + fileName, [ & ]()
+    {
+        for( CornerType vertex = 0; vertex < nVertices; vertex++ )
+            expectedAverages[ vertex ] = mesh->getVertexAverageEdgeLength( vertex );
+    } );
+
+    const char* names[] = { "scalar", "sse2", "avx2" };
+    GeometryKernels::InstructionSet supported = GeometryKernels::getSupportedInstructionSet();
+
+    for( int set = GeometryKernels::SCALAR; set <= supported; set++ )
+    {
+        GeometryKernels::setInstructionSet( ( GeometryKernels::InstructionSet )set );
+        std::string suffix = std::string( " (" ) + names[ set ] + ") " + fileName;
+
+        benchmark.run( "edge lengths" + suffix, [ & ]()
+        {
+            mesh->computeEdgeLengths( edgeLengths );
+        } );
+
+        benchmark.run( "face areas and normals" + suffix, [ & ]()
+        {
+            mesh->computeFaceAreasAndNormals( areas, normals );
+        } );
+
+        if( edgeLengths != expectedLengths )
+            printf( "    edge lengths differ from edgeLength\n" );
+
+        if( set == GeometryKernels::SCALAR )
+        {
+            scalarAreas = areas;
+            scalarNormals = normals;
+        }
+        else if( areas != scalarAreas || normals != scalarNormals )
+            printf( "    areas or normals differ from the scalar kernel\n" );
+    }
+
+    benchmark.run( "average edge lengths (batched) " + fileName, [ & ]()
+    {
+        mesh->computeVertexAverageEdgeLengths( edgeLengths, averages );
+    } );
+
+    if( averages != expectedAverages )
+        printf( "    averages differ from getVertexAverageEdgeLength\n" );
+}
+
+static void benchmarkVertexStar( Benchmark& benchmark, const std::string& fileName )
+{
+    auto mesh = OFFMeshLoader().parse( fileName );
+
+    if( !mesh )
+        return;
+
+    CornerType nVertices = mesh->getNumberVertices();
+    long long vectorSum = 0, rangeSum = 0, visitorSum = 0;
+
+    // Weighted by position so that a different order gives another sum
+    benchmark.run( "vertex stars (vector) " + fileName, [ & ]()
+    {
+        vectorSum = 0;
+
+        for( CornerType vertex = 0; vertex < nVertices; vertex++ )
+        {
+            long long position = 1;
+
+            for( CornerType corner : mesh->getCornerNeighbours( mesh->vertexToCornerIndex( vertex ) ) )
+                vectorSum += corner * position++;
+        }
+    } );
+
+    benchmark.run( "vertex stars (range) " + fileName, [ & ]()
+    {
+        rangeSum = 0;
+
+        for( CornerType vertex = 0; vertex < nVertices; vertex++ )
+        {
+            long long position = 1;
+
+            for( CornerType corner : mesh->getCornerStar( mesh->vertexToCornerIndex( vertex ) ) )
+                rangeSum += corner * position++;
+        }
+    } );
+
+    benchmark.run( "vertex stars (visitor) " + fileName, [ & ]()
+    {
+        visitorSum = 0;
+
+        for( CornerType vertex = 0; vertex < nVertices; vertex++ )
+        {
+            long long position = 1;
+
+            mesh->forEachCornerNeighbour( mesh->vertexToCornerIndex( vertex ), [ & ]( CornerType corner )
+            {
+                visitorSum += corner * position++;
+            } );
+        }
+    } );
+
+    if( rangeSum != vectorSum || visitorSum != vectorSum )
+        printf( "    stars differ from getCornerNeighbours\n" );
+}
+
+// Ring of 2 * n vertices around a hole of n vertices, on a wavy surface
+static std::shared_ptr< CornerTable > makeAnnulus( CornerType n )
+{
+    std::vector< double > vertices;
+    std::vector< CornerType > triangles;
+
+    for( CornerType ring = 0; ring < 2; ring++ )
+    {
+        double radius = 1.0 + ring;
+
+        for( CornerType i = 0; i < n; i++ )
+        {
+            double theta = 2 * M_PI * i / n;
+
+            vertices.push_back( radius * cos( theta ) );
+            vertices.push_back( radius * sin( theta ) );
+            vertices.push_back( 0.1 * sin( 5 * theta ) * radius );
+        }
+    }
+
+    for( CornerType i = 0; i < n; i++ )
+    {
+        CornerType next = ( i + 1 ) % n;
+
+        triangles.insert( triangles.end(), { i, n + i, n + next } );
+        triangles.insert( triangles.end(), { i, n + next, next } );
+    }
+
+    return std::make_shared< CornerTable >( std::move( triangles ), std::move( vertices ), 3 );
+}
+
+// Sphere of n rings of 2n vertices and two poles, without the triangles
+// of its first holeRings rings, so the hole is filled by a spherical cap
+static std::shared_ptr< CornerTable > makeHoledSphere( CornerType n, CornerType holeRings )
+{
+    std::vector< double > vertices;
+    std::vector< CornerType > triangles;
+    CornerType m = 2 * n;
+
+    for( CornerType i = 0; i < n; i++ )
+    {
+        double theta = M_PI * ( i + 1 ) / ( n + 1 );
+
+        for( CornerType j = 0; j < m; j++ )
+        {
+            double phi = 2 * M_PI * j / m;
+
+            vertices.push_back( sin( theta ) * cos( phi ) );
+            vertices.push_back( sin( theta ) * sin( phi ) );
+            vertices.push_back( cos( theta ) );
+        }
+    }
+
+    CornerType pole = n * m;
+    vertices.insert( vertices.end(), { 0., 0., -1. } );
+
+    for( CornerType i = holeRings; i + 1 < n; i++ )
+    {
+        for( CornerType j = 0; j < m; j++ )
+        {
+            CornerType v = i * m + j, next = i * m + ( j + 1 ) % m;
+
+            triangles.insert( triangles.end(), { v, v + m, next } );
+            triangles.insert( triangles.end(), { next, v + m, next + m } );
+        }
+    }
+
+    for( CornerType j = 0; j < m; j++ )
+        triangles.insert( triangles.end(), { ( n - 1 ) * m + j, pole, ( n - 1 ) * m + ( j + 1 ) % m } );
+
+    return std::make_shared< CornerTable >( std::move( triangles ), std::move( vertices ), 3 );
+}
+
+// Tracked border loops in the form of computeBorderLoops: each loop follows
+// its edges from its smallest vertex and is reversed, sorted by that vertex
+static std::vector< HoleBoundary > listTrackedLoops( CornerTable& mesh )
+{
+    std::vector< HoleBoundary > loops;
+
+    for( const std::pair< const CornerType, CornerType >& loop : mesh.getBorderLoops() )
+    {
+        HoleBoundary vertices;
+        CornerType vertex = loop.second;
+
+        do
+        {
+            vertices.push_back( vertex );
+            vertex = mesh.getNextBorderVertex( vertex );
+        }
+        while( vertex != loop.second && vertex != CornerTable::BORDER_CORNER &&
+               vertices.size() <= ( size_t )mesh.getNumberVertices() );
+
+        std::rotate( vertices.begin(), std::min_element( vertices.begin(), vertices.end() ), vertices.end() );
+        std::reverse( vertices.begin(), vertices.end() );
+        loops.push_back( vertices );
+    }
+
+    std::sort( loops.begin(), loops.end(), []( const HoleBoundary& a, const HoleBoundary& b )
+    {
+        return a.back() < b.back();
+    } );
+
+    return loops;
+}
+
+// Random flips and splits, inside the mesh and on its border, and now and
+// then the stitching of the patch of the smallest hole. The tracked loops are
+// compared with a complete scan after every operation.
+static void checkTrackedBorderLoops( const std::string& name, const CornerTable& mesh, size_t numberOperations )
+{
+    auto tracked = std::make_shared< CornerTable >( mesh );
+    tracked->trackBorderLoops();
+
+    HoleFiller holeFiller( tracked );
+    std::mt19937 random( 1 );
+    size_t numberStitches = 0;
+
+    for( size_t operation = 0; operation < numberOperations; operation++ )
+    {
+        unsigned int choice = random() % 100;
+        const std::map< CornerType, CornerType >& loops = tracked->getBorderLoops();
+
+        if( choice < 5 && !loops.empty() )
+        {
+            std::vector< HoleBoundary > holes = tracked->computeBorderLoops();
+            auto smallest = std::min_element( holes.begin(), holes.end(), []( const HoleBoundary& a, const HoleBoundary& b )
+            {
+                return a.size() < b.size();
+            } );
+
+            if( smallest->size() >= 3 && tracked->stitchPatch( *holeFiller.calculatePatchMesh(
+                *smallest, holeFiller.calculateMinimumPatchMesh( *smallest ) ), *smallest ) )
+                numberStitches++;
+        }
+        else if( choice < 50 )
+        {
+            CornerType corner = random() % ( 3 * tracked->getNumTriangles() );
+            CornerType opposite = tracked->cornerOpposite( corner );
+
+            if( opposite == CornerTable::BORDER_CORNER )
+                continue;
+
+            CornerType a = tracked->cornerToVertexIndex( corner ), b = tracked->cornerToVertexIndex( opposite );
+            bool isFlippable = ( a != b );
+
+            for( CornerType neighbour : tracked->getCornerStar( tracked->vertexToCornerIndex( a ) ) )
+                if( tracked->cornerToVertexIndex( neighbour ) == b )
+                    isFlippable = false;
+
+            if( isFlippable )
+                tracked->edgeFlip( corner );
+        }
+        else
+        {
+            // Half of the splits on the border
+            CornerType corner = random() % ( 3 * tracked->getNumTriangles() );
+
+            if( choice < 75 && !loops.empty() )
+            {
+                auto loop = loops.begin();
+                std::advance( loop, random() % loops.size() );
+                corner = tracked->getBorderCorner( loop->second );
+            }
+
+            CornerType a = tracked->cornerToVertexIndex( tracked->cornerNext( corner ) );
+            CornerType b = tracked->cornerToVertexIndex( tracked->cornerPrevious( corner ) );
+            double midpoint[ 3 ];
+
+            for( unsigned int k = 0; k < 3; k++ )
+                midpoint[ k ] = 0.5 * ( tracked->getCoordinate( a, k ) + tracked->getCoordinate( b, k ) );
+
+            tracked->edgeSplit( corner, midpoint );
+        }
+
+        if( listTrackedLoops( *tracked ) != tracked->computeBorderLoops() )
+        {
+            printf( "    tracked loops differ from the scan after %zu random edits of %s\n", operation + 1, name.c_str() );
+            return;
+        }
+    }
+
+    printf( "    tracked loops matched the scan after %zu random edits of %s (%zu stitches)\n", numberOperations,
+            name.c_str(), numberStitches );
+}
+
+static void benchmarkBorderLoops( Benchmark& benchmark, const std::string& name, std::shared_ptr< CornerTable > mesh )
+{
+    std::vector< HoleBoundary > holes, loops;
+
+    benchmark.run( "border loops (map) " + name, [ & ]()
+    {
+        holes = extractHoleBoundaries( *mesh );
+    } );
+
+    benchmark.run( "border loops (scan) " + name, [ & ]()
+    {
+        loops = mesh->computeBorderLoops();
+    } );
+
+    if( loops != holes )
+        printf( "    loops differ from the map based extraction\n" );
+
+#ifdef _OPENMP
+    CornerTable::setParallelBuildThreshold( 0 );
+
+    int maximumThreads = omp_get_max_threads();
+
+    for( int nThreads = 2; nThreads <= std::max( 2, maximumThreads ); nThreads *= 2 )
+    {
+        omp_set_num_threads( nThreads );
+
+        benchmark.run( "border loops (scan) " + name + " threads=" + std::to_string( nThreads ), [ & ]()
+        {
+            loops = mesh->computeBorderLoops();
+        } );
+
+        if( loops != holes )
+            printf( "    loops differ from the map based extraction\n" );
+
+        if( nThreads >= maximumThreads )
+            break;
+    }
+
+    omp_set_num_threads( maximumThreads );
+    CornerTable::setParallelBuildThreshold( 1 << 20 );
+#endif
+
+    if( holes.empty() )
+        return;
+
+    // Split a border edge and query the tracked loops
+    CornerTable tracked( *mesh );
+    tracked.trackBorderLoops();
+
+    benchmark.run( "border loops (tracked split) " + name, [ & ]()
+    {
+        CornerType corner = tracked.getBorderCorner( tracked.getBorderLoops().begin()->second );
+        CornerType a = tracked.cornerToVertexIndex( tracked.cornerNext( corner ) );
+        CornerType b = tracked.cornerToVertexIndex( tracked.cornerPrevious( corner ) );
+
+        double midpoint[ 3 ];
+
+        for( unsigned int k = 0; k < 3; k++ )
+            midpoint[ k ] = 0.5 * ( tracked.getCoordinate( a, k ) + tracked.getCoordinate( b, k ) );
+
+        tracked.edgeSplit( corner, midpoint );
+        tracked.getBorderLoops();
+    } );
+
+    if( listTrackedLoops( tracked ) != tracked.computeBorderLoops() )
+        printf( "    tracked loops differ from the scan\n" );
+
+    checkTrackedBorderLoops( name, *mesh, 1000 );
+}
+
+static void benchmarkHoleTriangulation( Benchmark& benchmark, const std::string& name,
+                                        std::shared_ptr< CornerTable > mesh, bool runLegacy )
+{
+    std::vector< HoleBoundary > holes = extractHoleBoundaries( *mesh );
+    std::vector< HoleBoundary > legacyPatches( holes.size() ), patches( holes.size() );
+    std::vector< HoleTriangulator::DihedralAngleWeight > legacyWeights( holes.size() ), weights( holes.size() );
+
+    if( runLegacy )
+    {
+        benchmark.run( "hole triangulation (map) " + name, [ & ]()
+        {
+            for( size_t h = 0; h < holes.size(); h++ )
+                legacyPatches[ h ] = legacyMinimumPatchMesh( mesh, holes[ h ], legacyWeights[ h ] );
+        } );
+    }
+
+    GeometryKernels::InstructionSet supported = GeometryKernels::getSupportedInstructionSet();
+
+    for( int set = GeometryKernels::SCALAR; set <= GeometryKernels::AVX2; set += GeometryKernels::AVX2 )
+    {
+        if( set > supported )
+            break;
+
+        GeometryKernels::setInstructionSet( ( GeometryKernels::InstructionSet )set );
+
+        HoleTriangulator triangulator( mesh );
+
+        benchmark.run( std::string( "hole triangulation (" ) + ( set == GeometryKernels::AVX2 ? "avx2" : "scalar" ) +
+                       ") " + name, [ & ]()
+        {
+            for( size_t h = 0; h < holes.size(); h++ )
+            {
+                patches[ h ] = triangulator.triangulate( holes[ h ] );
+                weights[ h ] = triangulator.getWeight();
+            }
+        } );
+
+        if( !runLegacy )
+            continue;
+
+        for( size_t h = 0; h < holes.size(); h++ )
+        {
+            if( patches[ h ] != legacyPatches[ h ] || weights[ h ].area != legacyWeights[ h ].area ||
+                !( weights[ h ].angle == legacyWeights[ h ].angle ||
+                   ( std::isnan( weights[ h ].angle ) && std::isnan( legacyWeights[ h ].angle ) ) ) )
+            {
+                printf( "    hole %zu (%zu vertices) differs from the map triangulation\n", h, holes[ h ].size() );
+            }
+        }
+    }
+
+    GeometryKernels::setInstructionSet( supported );
+}
+
+static void benchmarkTriangulationScaling( Benchmark& benchmark, CornerType maximumSize )
+{
+    // One repetition of the largest holes already takes seconds
+    unsigned int repetitions = benchmark.getRepetitions();
+    benchmark.setRepetitions( std::min( repetitions, 3u ) );
+
+    for( CornerType n = 100; n <= maximumSize; n = ( n % 3 == 0 ) ? 10 * n / 3 : 3 * n )
+    {
+        auto mesh = makeAnnulus( n );
+        HoleBoundary hole = extractHoleBoundaries( *mesh ).front();
+        std::string name = "annulus " + std::to_string( n );
+
+        HoleTriangulator triangulator( mesh );
+        HoleBoundary serialPatch, patch;
+
+        HoleTriangulator::setParallelThreshold( n + 1 );
+        HoleTriangulator::setTiledThreshold( n + 1 );
+
+        double serialTime = benchmark.run( "hole triangulation (by span) " + name, [ & ]()
+        {
+            serialPatch = triangulator.triangulate( hole );
+        } ).getMinimum();
+
+        HoleTriangulator::setTiledThreshold( 0 );
+
+        double tiledTime = benchmark.run( "hole triangulation (by tiles) " + name, [ & ]()
+        {
+            patch = triangulator.triangulate( hole );
+        } ).getMinimum();
+
+        printf( "    speedup %.2fx\n", serialTime / tiledTime );
+
+        if( patch != serialPatch )
+            printf( "    tiled triangulation differs from the serial one\n" );
+
+#ifdef _OPENMP
+        HoleTriangulator::setParallelThreshold( 0 );
+
+        int maximumThreads = omp_get_max_threads();
+
+        for( int nThreads = 2; nThreads <= std::max( 2, maximumThreads ); nThreads *= 2 )
+        {
+            omp_set_num_threads( nThreads );
+
+            for( int tiled = 0; tiled < 2; tiled++ )
+            {
+                HoleTriangulator::setTiledThreshold( tiled ? 0 : n + 1 );
+
+                double parallelTime = benchmark.run( std::string( "hole triangulation (" ) +
+                                                     ( tiled ? "by tiles" : "by span" ) + ") " + name +
+                                                     " threads=" + std::to_string( nThreads ), [ & ]()
+                {
+                    patch = triangulator.triangulate( hole );
+                } ).getMinimum();
+
+                printf( "    speedup %.2fx\n", serialTime / parallelTime );
+
+                if( patch != serialPatch )
+                    printf( "    parallel triangulation differs from the serial one\n" );
+            }
+
+            if( nThreads >= maximumThreads )
+                break;
+        }
+
+        omp_set_num_threads( maximumThreads );
+#endif
+    }
+
+    HoleTriangulator::setParallelThreshold( 512 );
+    HoleTriangulator::setTiledThreshold( 1024 );
+
+    benchmark.setRepetitions( repetitions );
+}
+
+static void benchmarkApproximateTriangulation( Benchmark& benchmark, const std::string& name,
+                                               std::shared_ptr< CornerTable > mesh, bool runExact )
+{
+    unsigned int repetitions = benchmark.getRepetitions();
+    benchmark.setRepetitions( std::min( repetitions, 3u ) );
+
+    std::vector< HoleBoundary > holes = extractHoleBoundaries( *mesh );
+    std::vector< HoleBoundary > exactPatches( holes.size() ), patches( holes.size() );
+    std::vector< HoleTriangulator::DihedralAngleWeight > exactWeights( holes.size() ), weights( holes.size() );
+
+    HoleTriangulator triangulator( mesh );
+
+    if( runExact )
+    {
+        benchmark.run( "hole triangulation (exact) " + name, [ & ]()
+        {
+            for( size_t h = 0; h < holes.size(); h++ )
+            {
+                exactPatches[ h ] = triangulator.triangulateExact( holes[ h ] );
+                exactWeights[ h ] = triangulator.getWeight();
+            }
+        } );
+    }
+
+    benchmark.run( "hole triangulation (approximate) " + name, [ & ]()
+    {
+        for( size_t h = 0; h < holes.size(); h++ )
+        {
+            patches[ h ] = triangulator.triangulateApproximate( holes[ h ] );
+            weights[ h ] = triangulator.getWeight();
+        }
+    } );
+
+    for( size_t h = 0; h < holes.size(); h++ )
+    {
+        if( holes[ h ].size() >= 3 && patches[ h ].size() != 3 * ( holes[ h ].size() - 2 ) )
+            printf( "    hole %zu (%zu vertices) has %zu triangles\n", h, holes[ h ].size(), patches[ h ].size() / 3 );
+
+        if( !runExact || holes[ h ].size() < 3 )
+            continue;
+
+        printf( "    hole %zu (%zu vertices) area %.6g exact %.6g (%+.3f%%), angle %.4g exact %.4g\n", h,
+                holes[ h ].size(), weights[ h ].area, exactWeights[ h ].area,
+                100 * ( weights[ h ].area - exactWeights[ h ].area ) / exactWeights[ h ].area,
+                weights[ h ].angle, exactWeights[ h ].angle );
+    }
+
+    benchmark.setRepetitions( repetitions );
+}
+
+// Patches made of the boundary vertices only, as the triangulation stage
+static std::vector< std::shared_ptr< CornerTable > > triangulateHoles( std::shared_ptr< CornerTable > mesh,
+                                                                      const std::vector< HoleBoundary >& holes )
+{
+    std::vector< std::shared_ptr< CornerTable > > patches;
+    HoleTriangulator triangulator( mesh );
+
+    for( const HoleBoundary& hole : holes )
+    {
+        HoleBoundary triangles = triangulator.triangulate( hole );
+        std::vector< double > vertices;
+
+        for( CornerType v : hole )
+            for( unsigned int k = 0; k < 3; k++ )
+                vertices.push_back( mesh->getCoordinate( v, k ) );
+
+        patches.push_back( std::make_shared< CornerTable >( triangles.data(), vertices.data(), triangles.size() / 3,
+                                                            hole.size(), 3 ) );
+    }
+
+    return patches;
+}
+
+static void benchmarkStitching( Benchmark& benchmark, const std::string& name, std::shared_ptr< CornerTable > mesh )
+{
+    std::vector< HoleBoundary > holes = mesh->computeBorderLoops();
+    std::vector< std::shared_ptr< CornerTable > > patches = triangulateHoles( mesh, holes );
+
+    std::shared_ptr< CornerTable > completed;
+    bool isStitched = true;
+
+    benchmark.run( "completed mesh (rebuild) " + name, [ & ]()
+    {
+        std::vector< CornerType > triangleList( mesh->getTriangleList(),
+                                                mesh->getTriangleList() + 3 * mesh->getNumTriangles() );
+
+        for( size_t h = 0; h < holes.size(); h++ )
+            for( CornerType i = 0; i < 3 * patches[ h ]->getNumTriangles(); i++ )
+                triangleList.push_back( holes[ h ][ patches[ h ]->getTriangleList()[ i ] ] );
+
+        completed = std::make_shared< CornerTable >( triangleList.data(), mesh->getAttributes(),
+                                                     triangleList.size() / 3, mesh->getNumberVertices(), 3 );
+    } );
+
+    CornerType numberTriangles = completed->getNumTriangles();
+
+    benchmark.run( "completed mesh (stitch) " + name, [ & ]()
+    {
+        completed = std::make_shared< CornerTable >( *mesh );
+
+        for( size_t h = 0; h < holes.size(); h++ )
+            isStitched = completed->stitchPatch( *patches[ h ], holes[ h ] ) && isStitched;
+    } );
+
+    if( !isStitched || completed->getNumTriangles() != numberTriangles || !completed->computeBorderLoops().empty() )
+        printf( "    stitched mesh is not closed\n" );
+
+    CornerTable tracked( *mesh );
+    tracked.trackBorderLoops();
+
+    for( size_t h = 0; h < holes.size(); h++ )
+        tracked.stitchPatch( *patches[ h ], holes[ h ] );
+
+    if( !tracked.getBorderLoops().empty() )
+        printf( "    tracked loops remain after stitching\n" );
+}
+
+static void benchmarkPatchRefinement( Benchmark& benchmark, const std::string& name, std::shared_ptr< CornerTable > mesh )
+{
+    std::vector< HoleBoundary > holes = mesh->computeBorderLoops();
+    std::vector< std::shared_ptr< CornerTable > > patches = triangulateHoles( mesh, holes ), refined( holes.size() );
+
+    std::vector< std::vector< PatchRefiner::RoundStatistics > > statistics( holes.size() );
+    std::vector< double > edgeLengths, scales;
+    mesh->computeEdgeLengths( edgeLengths );
+    mesh->computeVertexAverageEdgeLengths( edgeLengths, scales );
+
+    auto refineHoles = [ & ]()
+    {
+        for( size_t h = 0; h < holes.size(); h++ )
+        {
+            std::vector< double > boundaryScales;
+
+            for( CornerType v : holes[ h ] )
+                boundaryScales.push_back( scales[ v ] );
+
+            refined[ h ] = std::make_shared< CornerTable >( *patches[ h ] );
+
+            PatchRefiner refiner( refined[ h ], holes[ h ].size() );
+            refiner.refine( boundaryScales );
+            statistics[ h ] = refiner.getStatistics();
+        }
+    };
+
+    benchmark.run( "patch refinement " + name, refineHoles );
+
+#ifdef _OPENMP
+    std::vector< std::shared_ptr< CornerTable > > serial = refined;
+
+    PatchRefiner::setParallelThreshold( 0 );
+
+    int maximumThreads = omp_get_max_threads();
+
+    for( int nThreads = 2; nThreads <= std::max( 2, maximumThreads ); nThreads *= 2 )
+    {
+        omp_set_num_threads( nThreads );
+
+        benchmark.run( "patch refinement " + name + " threads=" + std::to_string( nThreads ), refineHoles );
+
+        for( size_t h = 0; h < holes.size(); h++ )
+        {
+            if( !isSameMesh( *refined[ h ], *serial[ h ] ) )
+                printf( "    hole %zu differs from the serial refinement\n", h );
+        }
+
+        if( nThreads >= maximumThreads )
+            break;
+    }
+
+    omp_set_num_threads( maximumThreads );
+    PatchRefiner::setParallelThreshold( 4096 );
+#endif
+
+    for( size_t h = 0; h < holes.size(); h++ )
+    {
+        PatchRefiner::RoundStatistics total;
+
+        for( const PatchRefiner::RoundStatistics& round : statistics[ h ] )
+        {
+            total.splits += round.splits;
+            total.checks += round.checks;
+            total.flips += round.flips;
+            total.isComplete = total.isComplete && round.isComplete;
+        }
+
+        printf( "    hole %zu: %zu rounds, %zu splits, %zu edge checks, %zu flips%s\n", h, statistics[ h ].size(),
+                total.splits, total.checks, total.flips, total.isComplete ? "" : ", stopped on the flip limit" );
+    }
+
+    std::vector< std::shared_ptr< CornerTable > > faired( holes.size() );
+    std::vector< PatchRefiner::FairingStatistics > fairingStatistics( holes.size() );
+    const char* modeNames[] = { "scalar", "harmonic", "second order" };
+
+    for( int mode = PatchRefiner::SCALAR; mode <= PatchRefiner::SECOND_ORDER; mode++ )
+    {
+        benchmark.run( std::string( "patch fairing (" ) + modeNames[ mode ] + ") " + name, [ & ]()
+        {
+            for( size_t h = 0; h < holes.size(); h++ )
+            {
+                faired[ h ] = std::make_shared< CornerTable >( *refined[ h ] );
+
+                PatchRefiner refiner( faired[ h ], holes[ h ].size() );
+                refiner.fair( ( PatchRefiner::FairingMode )mode );
+                fairingStatistics[ h ] = refiner.getFairingStatistics();
+            }
+        } );
+
+        for( size_t h = 0; h < holes.size(); h++ )
+        {
+            printf( "    hole %zu: %zu iterations, residual %.2e, %.3f ms\n", h, fairingStatistics[ h ].iterations,
+                    fairingStatistics[ h ].residual, fairingStatistics[ h ].milliseconds );
+        }
+    }
+
+    // The refined patches keep their boundary and close the mesh
+    CornerTable completed( *mesh );
+
+    for( size_t h = 0; h < holes.size(); h++ )
+    {
+        printf( "    hole %zu: %zu boundary vertices, %u vertices and %u triangles after the refinement\n", h,
+                holes[ h ].size(), ( unsigned int )refined[ h ]->getNumberVertices(),
+                ( unsigned int )refined[ h ]->getNumTriangles() );
+
+        if( !completed.stitchPatch( *faired[ h ], holes[ h ] ) )
+            printf( "    hole %zu: the refined patch does not match its boundary\n", h );
+    }
+
+    if( !completed.computeBorderLoops().empty() )
+        printf( "    completed mesh is not closed\n" );
+}
+
+// Copy of a mesh without the triangles within rings edges of numberHoles
+// vertices spread over it, so a closed scan gets holes of a realistic shape
+static std::shared_ptr< CornerTable > punchHoles( const CornerTable& mesh, CornerType numberHoles, CornerType rings )
+{
+    CornerType numberVertices = mesh.getNumberVertices();
+    CornerType numberTriangles = mesh.getNumTriangles();
+    const CornerType* triangleList = mesh.getTriangleList();
+
+    std::vector< bool > isRemovedVertex( numberVertices, false ), isRemovedTriangle( numberTriangles, false );
+
+    for( CornerType h = 0; h < numberHoles; h++ )
+        isRemovedVertex[ ( 2 * h + 1 ) * ( numberVertices / ( 2 * numberHoles ) ) ] = true;
+
+    // Each ring removes the triangles around the removed vertices, then
+    // removes all their vertices
+    for( CornerType ring = 0; ring < rings; ring++ )
+    {
+        for( CornerType t = 0; t < numberTriangles; t++ )
+        {
+            for( int k = 0; k < 3; k++ )
+                if( isRemovedVertex[ triangleList[ 3 * t + k ] ] )
+                    isRemovedTriangle[ t ] = true;
+        }
+
+        for( CornerType t = 0; t < numberTriangles; t++ )
+        {
+            if( isRemovedTriangle[ t ] )
+                for( int k = 0; k < 3; k++ )
+                    isRemovedVertex[ triangleList[ 3 * t + k ] ] = true;
+        }
+    }
+
+    // The vertices of the kept triangles, in their original order
+    std::vector< CornerType > newIndex( numberVertices, -1 ), triangles;
+    std::vector< double > vertices;
+
+    for( CornerType t = 0; t < numberTriangles; t++ )
+    {
+        if( !isRemovedTriangle[ t ] )
+            for( int k = 0; k < 3; k++ )
+                newIndex[ triangleList[ 3 * t + k ] ] = 0;
+    }
+
+    CornerType numberKept = 0;
+
+    for( CornerType v = 0; v < numberVertices; v++ )
+    {
+        if( newIndex[ v ] < 0 )
+            continue;
+
+        newIndex[ v ] = numberKept++;
+
+        for( unsigned int k = 0; k < 3; k++ )
+            vertices.push_back( mesh.getCoordinate( v, k ) );
+    }
+
+    for( CornerType t = 0; t < numberTriangles; t++ )
+    {
+        if( !isRemovedTriangle[ t ] )
+            for( int k = 0; k < 3; k++ )
+                triangles.push_back( newIndex[ triangleList[ 3 * t + k ] ] );
+    }
+
+    return std::make_shared< CornerTable >( std::move( triangles ), std::move( vertices ), 3 );
+}
+
+// The stages of the completion as the application runs them, one case by
+// stage over all the holes of the mesh
+static void benchmarkPipeline( Benchmark& benchmark, const std::string& name, std::shared_ptr< CornerTable > mesh )
+{
+    std::vector< CornerType > triangleList( mesh->getTriangleList(), mesh->getTriangleList() + 3 * mesh->getNumTriangles() );
+    std::vector< double > vertices( mesh->getAttributes(), mesh->getAttributes() + 3 * mesh->getNumberVertices() );
+
+    benchmark.run( "corner table construction " + name, [ & ]()
+    {
+        CornerTable( triangleList.data(), vertices.data(), mesh->getNumTriangles(), mesh->getNumberVertices(), 3 );
+    } );
+
+    HoleFiller holeFiller( mesh );
+
+    benchmark.run( "calculateHoleBoundaries " + name, [ & ]()
+    {
+        holeFiller.calculateHoleBoundaries();
+    } );
+
+    const std::vector< HoleBoundary >& holes = holeFiller.getBoundaries();
+    std::vector< HoleBoundary > triangulations( holes.size() );
+    std::vector< std::shared_ptr< CornerTable > > patches( holes.size() ), refined( holes.size() ), faired( holes.size() );
+
+    benchmark.run( "calculateMinimumPatchMesh " + name, [ & ]()
+    {
+        for( size_t h = 0; h < holes.size(); h++ )
+            triangulations[ h ] = holeFiller.calculateMinimumPatchMesh( holes[ h ] );
+    } );
+
+    for( size_t h = 0; h < holes.size(); h++ )
+        patches[ h ] = holeFiller.calculatePatchMesh( holes[ h ], triangulations[ h ] );
+
+    benchmark.run( "calculateRefinedPatchMesh " + name, [ & ]()
+    {
+        for( size_t h = 0; h < holes.size(); h++ )
+            refined[ h ] = holeFiller.calculateRefinedPatchMesh( patches[ h ], holes[ h ] );
+    } );
+
+    benchmark.run( "calculateFairedPatchMesh " + name, [ & ]()
+    {
+        for( size_t h = 0; h < holes.size(); h++ )
+            faired[ h ] = holeFiller.calculateFairedPatchMesh( refined[ h ], holes[ h ] );
+    } );
+
+    CornerTable completed( *mesh );
+    size_t numberVertices = 0;
+
+    for( size_t h = 0; h < holes.size(); h++ )
+    {
+        completed.stitchPatch( *faired[ h ], holes[ h ] );
+        numberVertices += faired[ h ]->getNumberVertices() - holes[ h ].size();
+    }
+
+    printf( "    %zu holes, %zu vertices added\n", holes.size(), numberVertices );
+
+    if( !completed.computeBorderLoops().empty() )
+        printf( "    completed mesh is not closed\n" );
+}
+
+// Topological operators, each case applied once to every triangle
+static void benchmarkEditOperations( Benchmark& benchmark, const std::string& name, std::shared_ptr< CornerTable > mesh )
+{
+    CornerType numberTriangles = mesh->getNumTriangles();
+    size_t numberFlips = 0;
+
+    // The operators change the mesh, so each run works on a copy of its own
+    std::vector< CornerTable > copies( benchmark.getRepetitions(), *mesh );
+    size_t run = 0;
+
+    // Only the flips that do not fold the mesh, checked as
+    // PatchRefiner::relaxEdge does
+    benchmark.run( "edgeFlip " + name, [ & ]()
+    {
+        CornerTable& flipped = copies[ run++ ];
+        numberFlips = 0;
+
+        for( CornerType t = 0; t < numberTriangles; t++ )
+        {
+            CornerType opposite = flipped.cornerOpposite( 3 * t );
+
+            if( opposite == CornerTable::BORDER_CORNER )
+                continue;
+
+            CornerType a = flipped.cornerToVertexIndex( 3 * t ), b = flipped.cornerToVertexIndex( opposite );
+            bool isFlippable = ( a != b );
+
+            for( CornerType neighbour : flipped.getCornerStar( flipped.vertexToCornerIndex( a ) ) )
+                if( flipped.cornerToVertexIndex( neighbour ) == b )
+                    isFlippable = false;
+
+            if( isFlippable && flipped.edgeFlip( 3 * t ) )
+                numberFlips++;
+        }
+    } );
+
+    copies.assign( benchmark.getRepetitions(), *mesh );
+    run = 0;
+
+    benchmark.run( "edgeSplit " + name, [ & ]()
+    {
+        CornerTable& split = copies[ run++ ];
+        const CornerType* triangleList = split.getTriangleList();
+
+        for( CornerType t = 0; t < numberTriangles; t++ )
+        {
+            double midpoint[ 3 ];
+            CornerType a = triangleList[ 3 * t + 1 ], b = triangleList[ 3 * t + 2 ];
+
+            for( unsigned int k = 0; k < 3; k++ )
+                midpoint[ k ] = 0.5 * ( split.getCoordinate( a, k ) + split.getCoordinate( b, k ) );
+
+            split.edgeSplit( 3 * t, midpoint );
+            triangleList = split.getTriangleList();
+        }
+    } );
+
+    long long sum = 0;
+
+    benchmark.run( "getCornerNeighbours " + name, [ & ]()
+    {
+        sum = 0;
+
+        for( CornerType corner = 0; corner < 3 * numberTriangles; corner++ )
+            sum += mesh->getCornerNeighbours( corner ).size();
+    } );
+
+    printf( "    %zu flips, %lld neighbours\n", numberFlips, sum );
+}
+
+int main( int argc, char** argv )
+{
+    unsigned int repetitions = 10;
+    CornerType maximumHoleSize = 3000;
+    std::string jsonFile, baselineFile;
+    double tolerance = 0.1;
+    int position = 0;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( !strcmp( argv[ i ], "--json" ) && i + 1 < argc )
+            jsonFile = argv[ ++i ];
+        else if( !strcmp( argv[ i ], "--baseline" ) && i + 1 < argc )
+            baselineFile = argv[ ++i ];
+        else if( !strcmp( argv[ i ], "--tolerance" ) && i + 1 < argc )
+            tolerance = atof( argv[ ++i ] );
+        else if( position == 0 && argv[ i ][ 0 ] != '-' )
+            repetitions = atoi( argv[ i ] ), position++;
+        else if( position == 1 && argv[ i ][ 0 ] != '-' )
+            maximumHoleSize = atoi( argv[ i ] ), position++;
+        else
+        {
+            fprintf( stderr, "Usage: %s [repetitions] [maximum hole size] [--json results.json] "
+                             "[--baseline baseline.json] [--tolerance 0.1]\n", argv[ 0 ] );
+            return 2;
+        }
+    }
+
+    // Read first, so a missing baseline fails before the runs
+    std::vector< Benchmark::Result > baseline;
+
+    if( !baselineFile.empty() && !Benchmark::readJSON( baselineFile, baseline ) )
+    {
+        fprintf( stderr, "Could not read the baseline %s\n", baselineFile.c_str() );
+        return 2;
+    }
+
+    Benchmark benchmark( repetitions );
+
+    benchmarkLoader( benchmark, "data/bunny.off" );
+    benchmarkLoader( benchmark, "data/bunny_hole.off" );
+    benchmarkLoader( benchmark, "data/dragon.off" );
+
+    benchmarkParallelLoader( benchmark, "data/dragon.off" );
+
+    benchmarkCachedLoader( benchmark, "data/bunny_hole.off" );
+    benchmarkCachedLoader( benchmark, "data/dragon.off" );
+
+    benchmarkOppositeTable( benchmark, "data/bunny.off" );
+    benchmarkOppositeTable( benchmark, "data/dragon.off" );
+
+    benchmarkVertexStorage( benchmark, "data/dragon.off" );
+
+    benchmarkGeometryKernels( benchmark, "data/dragon.off" );
+
+    benchmarkVertexStar( benchmark, "data/bunny_hole.off" );
+    benchmarkVertexStar( benchmark, "data/dragon.off" );
+
+    auto bunnyHole = OFFMeshLoader().parse( "data/bunny_hole.off" );
+    auto dragon = OFFMeshLoader().parse( "data/dragon.off" );
+
+    if( bunnyHole )
+        benchmarkBorderLoops( benchmark, "data/bunny_hole.off", bunnyHole );
+
+    if( dragon )
+        benchmarkBorderLoops( benchmark, "data/dragon.off", dragon );
+
+    benchmarkBorderLoops( benchmark, "annulus 100000", makeAnnulus( 100000 ) );
+
+    if( bunnyHole )
+        benchmarkHoleTriangulation( benchmark, "data/bunny_hole.off", bunnyHole, true );
+
+    benchmarkHoleTriangulation( benchmark, "annulus 200", makeAnnulus( 200 ), true );
+    benchmarkHoleTriangulation( benchmark, "annulus 1000", makeAnnulus( 1000 ), false );
+
+    benchmarkTriangulationScaling( benchmark, maximumHoleSize );
+
+    if( bunnyHole )
+        benchmarkApproximateTriangulation( benchmark, "data/bunny_hole.off", bunnyHole, true );
+
+    benchmarkApproximateTriangulation( benchmark, "annulus 1000", makeAnnulus( 1000 ), true );
+    benchmarkApproximateTriangulation( benchmark, "annulus 3000", makeAnnulus( 3000 ), true );
+    benchmarkApproximateTriangulation( benchmark, "annulus 20000", makeAnnulus( 20000 ), false );
+
+    if( bunnyHole )
+        benchmarkPatchRefinement( benchmark, "data/bunny_hole.off", bunnyHole );
+
+    benchmarkPatchRefinement( benchmark, "annulus 200", makeAnnulus( 200 ) );
+    benchmarkPatchRefinement( benchmark, "sphere 200 hole 40", makeHoledSphere( 200, 40 ) );
+
+    if( bunnyHole )
+        benchmarkStitching( benchmark, "data/bunny_hole.off", bunnyHole );
+
+    benchmarkStitching( benchmark, "annulus 1000", makeAnnulus( 1000 ) );
+
+    std::shared_ptr< CornerTable > dragonHoles = dragon ? punchHoles( *dragon, 8, 4 ) : nullptr;
+
+    if( bunnyHole )
+        benchmarkPipeline( benchmark, "data/bunny_hole.off", bunnyHole );
+
+    if( dragonHoles )
+        benchmarkPipeline( benchmark, "data/dragon.off 8 holes", dragonHoles );
+
+    if( bunnyHole )
+        benchmarkEditOperations( benchmark, "data/bunny_hole.off", bunnyHole );
+
+    if( dragon )
+        benchmarkEditOperations( benchmark, "data/dragon.off", dragon );
+
+    if( !jsonFile.empty() && !benchmark.writeJSON( jsonFile ) )
+        fprintf( stderr, "Could not write %s\n", jsonFile.c_str() );
+
+    if( !baselineFile.empty() && benchmark.compare( baseline, tolerance ) > 0 )
+        return 1;
+
+    return 0;
+}
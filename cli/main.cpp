@@ -0,0 +1,180 @@
+/*
+ * File:   main.cpp
+ *
+ * Created on October 16, 2026
+ *
+ * Hole filling without any window, for machines with no display:
+ * bin/mccli input.off output.off [--fairing none|scalar|harmonic|second-order]
+ *           [--threads n] [--cache] [--trace trace.json]
+ *           [--statistics statistics.json|statistics.csv]
+ *
+ * --cache reloads the mesh from, or writes, the binary cache next to the input
+ * file (input.off.mcc).
+ * --trace writes the timeline of the run as a Chrome trace, if the zones were
+ * compiled in (make TRACE=1). --statistics writes the counters of each hole,
+ * as CSV if the file name ends with .csv and as JSON otherwise.
+ */
+
+#include "../src/OFFMeshLoader.h"
+#include "../src/OFFMeshWriter.h"
+#include "../src/HoleFiller.h"
+#include "../src/Trace.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static double millisecondsSince( std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+}
+
+static bool parseFairingMode( const char* name, HoleFiller::FairingMode& mode )
+{
+    if( !strcmp( name, "none" ) )
+        mode = HoleFiller::NONE;
+    else if( !strcmp( name, "scalar" ) )
+        mode = HoleFiller::SCALAR;
+    else if( !strcmp( name, "harmonic" ) )
+        mode = HoleFiller::HARMONIC;
+    else if( !strcmp( name, "second-order" ) )
+        mode = HoleFiller::SECOND_ORDER;
+    else
+        return false;
+
+    return true;
+}
+
+static int printUsage( const char* program )
+{
+    fprintf( stderr, "Usage: %s input.off output.off [--fairing none|scalar|harmonic|second-order] "
+                     "[--threads n] [--cache] [--trace trace.json] "
+                     "[--statistics statistics.json|statistics.csv]\n", program );
+
+    return 1;
+}
+
+int main( int argc, char** argv )
+{
+    HoleFiller::FairingMode fairingMode = HoleFiller::SCALAR;
+    int numberThreads = 0;
+    bool isCacheEnabled = false;
+    std::string input, output, traceFile, statisticsFile;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( !strcmp( argv[ i ], "--fairing" ) && i + 1 < argc )
+        {
+            if( !parseFairingMode( argv[ ++i ], fairingMode ) )
+                return printUsage( argv[ 0 ] );
+        }
+        else if( !strcmp( argv[ i ], "--threads" ) && i + 1 < argc )
+            numberThreads = atoi( argv[ ++i ] );
+        else if( !strcmp( argv[ i ], "--trace" ) && i + 1 < argc )
+            traceFile = argv[ ++i ];
+        else if( !strcmp( argv[ i ], "--statistics" ) && i + 1 < argc )
+            statisticsFile = argv[ ++i ];
+        else if( !strcmp( argv[ i ], "--cache" ) )
+            isCacheEnabled = true;
+        else if( argv[ i ][ 0 ] == '-' )
+            return printUsage( argv[ 0 ] );
+        else if( input.empty() )
+            input = argv[ i ];
+        else if( output.empty() )
+            output = argv[ i ];
+        else
+            return printUsage( argv[ 0 ] );
+    }
+
+    if( output.empty() )
+        return printUsage( argv[ 0 ] );
+
+#ifndef MC_TRACING
+    if( !traceFile.empty() )
+        fprintf( stderr, "Built without the trace zones (make TRACE=1), the trace will be empty\n" );
+#endif
+
+    Trace::setEnabled( !traceFile.empty() );
+
+    // Every parallel region of the run, not only the loader and the loop over
+    // the holes, is limited to the given number of threads
+#ifdef _OPENMP
+    if( numberThreads > 0 )
+        omp_set_num_threads( numberThreads );
+#endif
+
+    auto start = std::chrono::steady_clock::now();
+
+    OFFMeshLoader loader;
+    loader.setCacheEnabled( isCacheEnabled );
+
+    if( numberThreads > 0 )
+        loader.setNumberThreads( numberThreads );
+
+    auto step = std::chrono::steady_clock::now();
+    std::shared_ptr< CornerTable > cornerTable = loader.parse( input );
+
+    if( !cornerTable )
+    {
+        fprintf( stderr, "Could not load %s\n", input.c_str() );
+        return 1;
+    }
+
+    printf( "Loading: %g ms (%d vertices, %d triangles)\n", millisecondsSince( step ),
+            cornerTable->getNumberVertices(), cornerTable->getNumTriangles() );
+
+    step = std::chrono::steady_clock::now();
+    HoleFiller holeFiller( cornerTable );
+    holeFiller.setFairingMode( fairingMode );
+    holeFiller.setNumberThreads( numberThreads );
+
+    printf( "Boundaries: %g ms (%zu holes)\n", millisecondsSince( step ), holeFiller.getBoundaries().size() );
+    fflush( stdout );
+
+    holeFiller.fill();
+
+    std::shared_ptr< CornerTable > completedMesh = holeFiller.getCompletedMesh();
+
+    step = std::chrono::steady_clock::now();
+
+    if( !OFFMeshWriter().write( output, *completedMesh ) )
+    {
+        fprintf( stderr, "Could not write %s\n", output.c_str() );
+        return 1;
+    }
+
+    printf( "Writing: %g ms (%d vertices, %d triangles)\n", millisecondsSince( step ),
+            completedMesh->getNumberVertices(), completedMesh->getNumTriangles() );
+    printf( "Total: %g ms\n", millisecondsSince( start ) );
+
+    if( !statisticsFile.empty() )
+    {
+        bool isCSV = statisticsFile.size() >= 4 && statisticsFile.compare( statisticsFile.size() - 4, 4, ".csv" ) == 0;
+
+        if( !( isCSV ? holeFiller.writeStatisticsCSV( statisticsFile ) : holeFiller.writeStatisticsJSON( statisticsFile ) ) )
+        {
+            fprintf( stderr, "Could not write %s\n", statisticsFile.c_str() );
+            return 1;
+        }
+    }
+
+    if( !traceFile.empty() )
+    {
+        if( !Trace::writeChromeJSON( traceFile ) )
+        {
+            fprintf( stderr, "Could not write %s\n", traceFile.c_str() );
+            return 1;
+        }
+
+        if( Trace::getNumberDroppedZones() > 0 )
+            printf( "Trace: %zu zones dropped\n", Trace::getNumberDroppedZones() );
+    }
+
+    return 0;
+}
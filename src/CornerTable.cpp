@@ -1,125 +1,1134 @@
 #include "CornerTable.h"
+#include "GeometryKernels.h"
 #include <cstdio>
 #include <vector>
-#include <list>
 #include <cmath>
+#include <utility>
 
 #include <iostream>
+#include <algorithm>
 #include <stdlib.h>
 #include <assert.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+static inline int omp_get_max_threads( )
+{
+    return 1;
+}
+
+static inline int omp_get_num_threads( )
+{
+    return 1;
+}
+
+static inline int omp_get_thread_num( )
+{
+    return 0;
+}
+#endif
+
 using namespace std;
 
 
 
-CornerTable::CornerTable( const CornerType* triangleList, double* vertexList,
-                          const CornerType numberTriangles, const CornerType numberVertices,
-                          const unsigned int numberCoordinatesByVertex )
-{
-    //Copy the counters to the Corner Table.
-    _numberVertices = numberVertices;
-    _numberTriangles = numberTriangles;
-    _numberCoordinatesByVertex = numberCoordinatesByVertex;
-    _maximumPoints = numberVertices;
-    _maximumTriangles = numberTriangles;
-    _reallocationFactor = 2;
+template< class Storage >
+const CornerType CornerTableT< Storage >::BORDER_CORNER;
+
+//Minimum number of corners to build the opposite table in parallel. It is
+//shared by all the storage policies.
+static CornerType parallelBuildThreshold = 1 << 20;
+
+
+
+/**
+ * Stable LSD radix sort of the keys and their corners with the OpenMP threads.
+ * Each pass sorts 11 bits: every thread counts the digits of a contiguous
+ * block, the counters are turned into offsets ordered by digit and thread, and
+ * every thread scatters its block.
+ * @param keys - keys to be sorted.
+ * @param corners - corner of each key, moved with it.
+ * @param keyBits - number of significant bits of the keys.
+ */
+static void radixSortEdgeKeys( std::vector< uint64_t >& keys, std::vector< CornerType >& corners,
+                               const unsigned int keyBits )
+{
+    const unsigned int DIGIT_BITS = 11;
+    const size_t RADIX = ( size_t ) 1 << DIGIT_BITS;
+    const size_t numberKeys = keys.size( );
+
+    std::vector< uint64_t > sortedKeys( numberKeys );
+    std::vector< CornerType > sortedCorners( numberKeys );
+    std::vector< size_t > offsets( omp_get_max_threads( ) * RADIX );
+
+    for (unsigned int shift = 0; shift < keyBits; shift += DIGIT_BITS)
+    {
+        #pragma omp parallel
+        {
+            size_t numberThreads = omp_get_num_threads( );
+            size_t thread = omp_get_thread_num( );
+            size_t begin = numberKeys * thread / numberThreads;
+            size_t end = numberKeys * ( thread + 1 ) / numberThreads;
+            size_t* offset = &offsets[thread * RADIX];
+
+            std::fill( offset, offset + RADIX, 0 );
+            for (size_t i = begin; i < end; i++)
+            {
+                offset[( keys[i] >> shift ) & ( RADIX - 1 )]++;
+            }
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                size_t position = 0;
+                for (size_t digit = 0; digit < RADIX; digit++)
+                {
+                    for (size_t t = 0; t < numberThreads; t++)
+                    {
+                        size_t count = offsets[t * RADIX + digit];
+                        offsets[t * RADIX + digit] = position;
+                        position += count;
+                    }
+                }
+            }
+
+            for (size_t i = begin; i < end; i++)
+            {
+                size_t position = offset[( keys[i] >> shift ) & ( RADIX - 1 )]++;
+                sortedKeys[position] = keys[i];
+                sortedCorners[position] = corners[i];
+            }
+        }
+
+        keys.swap( sortedKeys );
+        corners.swap( sortedCorners );
+    }
+}
+
+
+
+template< class Storage >
+CornerTableT< Storage >::CornerTableT( const CornerType* triangleList, double* vertexList,
+                                       const CornerType numberTriangles, const CornerType numberVertices,
+                                       const unsigned int numberCoordinatesByVertex )
+{
+    //Copy the counters to the Corner Table.
+    _numberVertices = numberVertices;
+    _numberTriangles = numberTriangles;
+    _numberCoordinatesByVertex = numberCoordinatesByVertex;
+    _maximumPoints = numberVertices;
+    _maximumTriangles = numberTriangles;
+    _reallocationFactor = 2;
+    _isTrackingBorder = false;
+    _nextBorderLoopId = 0;
+
+    //Allocate the vectors.
+    _cornerToVertex = std::vector<CornerType>( 3 * numberTriangles );
+    _vertexToCorner = std::vector<CornerType>( numberVertices );
+    _oppositeCorner = std::vector<CornerType>( 3 * numberTriangles );
+
+    //Coppy the informations.
+    memcpy( &_cornerToVertex[0], triangleList, 3 * numberTriangles * sizeof (CornerType ) );
+    _attributes.assign( vertexList, numberVertices, numberCoordinatesByVertex );
+
+    //Initialize vectors
+    memset( &_vertexToCorner[0], 0, numberVertices * sizeof (CornerType ) );
+    for (CornerType i = 0; i < 3 * _numberTriangles; i++)
+    {
+        _oppositeCorner[i] = BORDER_CORNER;
+    }
+
+    //Build the opposite table.
+    buildOppositeTable( );
+}
+
+
+
+template< class Storage >
+CornerTableT< Storage >::CornerTableT( std::vector<CornerType>&& triangleList, std::vector<double>&& vertexList,
+                                       const unsigned int numberCoordinatesByVertex )
+{
+    //Copy the counters to the Corner Table.
+    _numberVertices = vertexList.size( ) / numberCoordinatesByVertex;
+    _numberTriangles = triangleList.size( ) / 3;
+    _numberCoordinatesByVertex = numberCoordinatesByVertex;
+    _maximumPoints = _numberVertices;
+    _maximumTriangles = _numberTriangles;
+    _reallocationFactor = 2;
+    _isTrackingBorder = false;
+    _nextBorderLoopId = 0;
+
+    //Take the vectors without copying them. The vertex list is only copied
+    //if the storage has another precision or layout.
+    _cornerToVertex = std::move( triangleList );
+    _attributes.assign( std::move( vertexList ), numberCoordinatesByVertex );
+
+    //Allocate and initialize the remaining vectors.
+    _vertexToCorner = std::vector<CornerType>( _numberVertices, 0 );
+    _oppositeCorner = std::vector<CornerType>( 3 * _numberTriangles, BORDER_CORNER );
+
+    //Build the opposite table.
+    buildOppositeTable( );
+}
+
+
+
+template< class Storage >
+CornerTableT< Storage >::CornerTableT( std::vector<CornerType>&& triangleList, std::vector<CornerType>&& oppositeList,
+                                       std::vector<CornerType>&& vertexToCornerList, std::vector<double>&& vertexList,
+                                       const unsigned int numberCoordinatesByVertex,
+                                       std::vector<CornerType>&& nonManifoldList )
+{
+    //Copy the counters to the Corner Table.
+    _numberVertices = vertexList.size( ) / numberCoordinatesByVertex;
+    _numberTriangles = triangleList.size( ) / 3;
+    _numberCoordinatesByVertex = numberCoordinatesByVertex;
+    _maximumPoints = _numberVertices;
+    _maximumTriangles = _numberTriangles;
+    _reallocationFactor = 2;
+    _isTrackingBorder = false;
+    _nextBorderLoopId = 0;
+
+    //Take the complete tables.
+    _cornerToVertex = std::move( triangleList );
+    _oppositeCorner = std::move( oppositeList );
+    _vertexToCorner = std::move( vertexToCornerList );
+    _attributes.assign( std::move( vertexList ), numberCoordinatesByVertex );
+    _nonManifoldCorners = std::move( nonManifoldList );
+
+    assert( _oppositeCorner.size( ) == _cornerToVertex.size( ) );
+    assert( _vertexToCorner.size( ) == ( size_t ) _numberVertices );
+}
+
+
+
+template< class Storage >
+CornerTableT< Storage >::~CornerTableT( )
+{
+}
+
+
+
+template< class Storage >
+unsigned int CornerTableT< Storage >::getNumberAttributesByVertex( ) const
+{
+    return _numberCoordinatesByVertex;
+}
+
+
+
+template< class Storage >
+size_t CornerTableT< Storage >::getAllocatedBytes( ) const
+{
+    size_t bytes = _attributes.getAllocatedBytes( );
+    bytes += ( _nonManifoldCorners.capacity( ) + _oppositeCorner.capacity( ) +
+               _cornerToVertex.capacity( ) + _vertexToCorner.capacity( ) +
+               _borderCornerOfVertex.capacity( ) + _previousBorderVertex.capacity( ) +
+               _loopOfVertex.capacity( ) + _dirtyBorderVertices.capacity( ) +
+               _lastNextBorderVertex.capacity( ) + _updatedBorderTriangles.capacity( ) ) * sizeof( CornerType );
+    bytes += _isDirtyBorderVertex.capacity( ) / 8;
+    bytes += _borderLoops.size( ) * ( sizeof( std::pair< const CornerType, CornerType > ) + 4 * sizeof( void* ) );
+    return bytes;
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::getNumberVertices( ) const
+{
+    return _numberVertices;
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::getNumTriangles( ) const
+{
+    return _numberTriangles;
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::cornerToVertexIndex( const CornerType corner ) const
+{
+    return _cornerToVertex[corner];
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::vertexToCornerIndex( const CornerType vertex ) const
+{
+    return _vertexToCorner[ vertex ];
+}
+
+
+
+template< class Storage >
+const CornerType* CornerTableT< Storage >::getTriangleList( ) const
+{
+    return &_cornerToVertex[0];
+}
+
+
+
+template< class Storage >
+const CornerType* CornerTableT< Storage >::getOppositeList( ) const
+{
+    return &_oppositeCorner[0];
+}
+
+
+
+template< class Storage >
+const CornerType* CornerTableT< Storage >::getVertexToCornerList( ) const
+{
+    return &_vertexToCorner[0];
+}
+
+
+
+template< class Storage >
+const std::vector<CornerType>& CornerTableT< Storage >::getNonManifoldCorners( ) const
+{
+    return _nonManifoldCorners;
+}
+
+
+
+template< class Storage >
+std::vector< std::vector<CornerType> > CornerTableT< Storage >::computeBorderLoops( ) const
+{
+    CornerType totalCorners = 3 * _numberTriangles;
+
+    //Border corners in increasing order, each thread scanning a contiguous
+    //range of the opposite table.
+    bool isParallel = omp_get_max_threads( ) > 1 && totalCorners >= parallelBuildThreshold;
+    std::vector< std::vector< CornerType > > borderByThread( isParallel ? omp_get_max_threads( ) : 1 );
+
+    #pragma omp parallel if(isParallel)
+    {
+        std::vector< CornerType >& border = borderByThread[omp_get_thread_num( )];
+
+        #pragma omp for schedule(static)
+        for (CornerType corner = 0; corner < totalCorners; corner++)
+        {
+            if (_oppositeCorner[corner] == BORDER_CORNER)
+            {
+                border.push_back( corner );
+            }
+        }
+    }
+
+    //Following vertex on the border. If a vertex starts several border
+    //edges, the last corner wins. Degenerated edges are not followed.
+    std::vector< CornerType > nextBorderVertex( _numberVertices, BORDER_CORNER );
+
+    for (const std::vector< CornerType >& border : borderByThread)
+    {
+        for (CornerType corner : border)
+        {
+            CornerType from = _cornerToVertex[cornerNext( corner )];
+            CornerType to = _cornerToVertex[cornerPrevious( corner )];
+
+            if (from != to)
+            {
+                nextBorderVertex[from] = to;
+            }
+        }
+    }
+
+    std::vector< std::vector<CornerType> > loops;
+    std::vector< bool > isVisited( _numberVertices, false );
+
+    for (CornerType vertex = 0; vertex < _numberVertices; vertex++)
+    {
+        if (nextBorderVertex[vertex] == BORDER_CORNER || isVisited[vertex])
+        {
+            continue;
+        }
+
+        std::vector< CornerType > loop;
+        CornerType currentVertex = vertex;
+
+        //Stop at the start, or at a vertex without a border edge left.
+        while (!isVisited[currentVertex] && nextBorderVertex[currentVertex] != BORDER_CORNER)
+        {
+            loop.push_back( currentVertex );
+            isVisited[currentVertex] = true;
+            currentVertex = nextBorderVertex[currentVertex];
+        }
+
+        std::reverse( loop.begin( ), loop.end( ) );
+        loops.push_back( loop );
+    }
+
+    return loops;
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::trackBorderLoops( )
+{
+    _isTrackingBorder = true;
+    rebuildBorderLoops( );
+}
+
+
+
+template< class Storage >
+const std::map< CornerType, CornerType >& CornerTableT< Storage >::getBorderLoops( )
+{
+    if (!_isTrackingBorder)
+    {
+        trackBorderLoops( );
+    }
+
+    if (_dirtyBorderVertices.empty( ))
+    {
+        return _borderLoops;
+    }
+
+    //An open chain, or a vertex shared by two loops, is left to the
+    //complete computation.
+    if (!spliceBorderLoops( ) && !walkBorderLoops( ))
+    {
+        rebuildBorderLoops( );
+        return _borderLoops;
+    }
+
+    clearDirtyBorderVertices( );
+
+    return _borderLoops;
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::getBorderCorner( const CornerType vertex ) const
+{
+    return _borderCornerOfVertex[vertex];
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::getNextBorderVertex( const CornerType vertex ) const
+{
+    CornerType corner = _borderCornerOfVertex[vertex];
+
+    return corner == BORDER_CORNER ? BORDER_CORNER : _cornerToVertex[cornerPrevious( corner )];
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::getPreviousBorderVertex( const CornerType vertex ) const
+{
+    return _previousBorderVertex[vertex];
+}
+
+
+
+template< class Storage >
+bool CornerTableT< Storage >::spliceBorderLoops( )
+{
+    size_t maximumSteps = _dirtyBorderVertices.size( );
+
+    //Next border vertex at the last getBorderLoops.
+    auto lastNext = [&] ( const CornerType vertex )
+    {
+        return _isDirtyBorderVertex[vertex] ? _lastNextBorderVertex[vertex] : getNextBorderVertex( vertex );
+    };
+
+    //A vertex on the border before and after the changes keeps its loop.
+    auto isAnchor = [&] ( const CornerType vertex )
+    {
+        return lastNext( vertex ) != BORDER_CORNER && getNextBorderVertex( vertex ) != BORDER_CORNER;
+    };
+
+    //Vertices that joined and left the border between two anchors, with the
+    //first anchor. Nothing is changed until every path is checked.
+    std::vector< std::pair<CornerType, CornerType> > joined, left;
+
+    for (CornerType anchor : _dirtyBorderVertices)
+    {
+        if (!isAnchor( anchor ))
+        {
+            continue;
+        }
+
+        if (_loopOfVertex[anchor] == BORDER_CORNER)
+        {
+            return false;
+        }
+
+        size_t steps = 0;
+        CornerType previous = anchor;
+        CornerType vertex = getNextBorderVertex( anchor );
+
+        while (_previousBorderVertex[vertex] == previous && !isAnchor( vertex ))
+        {
+            if (getNextBorderVertex( vertex ) == BORDER_CORNER || ++steps > maximumSteps)
+            {
+                return false;
+            }
+
+            joined.push_back( std::make_pair( vertex, anchor ) );
+            previous = vertex;
+            vertex = getNextBorderVertex( vertex );
+        }
+
+        if (_previousBorderVertex[vertex] != previous)
+        {
+            return false;
+        }
+
+        CornerType end = vertex;
+        steps = 0;
+        vertex = lastNext( anchor );
+
+        while (!isAnchor( vertex ))
+        {
+            if (lastNext( vertex ) == BORDER_CORNER || ++steps > maximumSteps)
+            {
+                return false;
+            }
+
+            left.push_back( std::make_pair( vertex, anchor ) );
+            vertex = lastNext( vertex );
+        }
+
+        //The anchors keep their order, so no loop was split or merged.
+        if (vertex != end)
+        {
+            return false;
+        }
+    }
+
+    //The other vertices that joined or left the border make whole loops.
+    std::vector<CornerType> joinedVertices, leftVertices;
+    for (const std::pair<CornerType, CornerType>& vertexAnchor : joined)
+    {
+        joinedVertices.push_back( vertexAnchor.first );
+    }
+    for (const std::pair<CornerType, CornerType>& vertexAnchor : left)
+    {
+        leftVertices.push_back( vertexAnchor.first );
+    }
+    std::sort( joinedVertices.begin( ), joinedVertices.end( ) );
+    std::sort( leftVertices.begin( ), leftVertices.end( ) );
+
+    std::vector<CornerType> newLoops, removedLoops;
+
+    for (CornerType vertex : _dirtyBorderVertices)
+    {
+        bool isJoined = lastNext( vertex ) == BORDER_CORNER && getNextBorderVertex( vertex ) != BORDER_CORNER;
+        bool isLeft = lastNext( vertex ) != BORDER_CORNER && getNextBorderVertex( vertex ) == BORDER_CORNER;
+
+        if (isJoined && !std::binary_search( joinedVertices.begin( ), joinedVertices.end( ), vertex ))
+        {
+            size_t steps = 0;
+            CornerType current = vertex;
+
+            do
+            {
+                CornerType next = getNextBorderVertex( current );
+                if (next == BORDER_CORNER || isAnchor( next ) || _previousBorderVertex[next] != current ||
+                    ++steps > maximumSteps)
+                {
+                    return false;
+                }
+                joinedVertices.push_back( next );
+                current = next;
+            }
+            while (current != vertex);
+
+            std::sort( joinedVertices.begin( ), joinedVertices.end( ) );
+            newLoops.push_back( vertex );
+        }
+        else if (isLeft && !std::binary_search( leftVertices.begin( ), leftVertices.end( ), vertex ))
+        {
+            size_t steps = 0;
+            CornerType current = vertex;
+
+            do
+            {
+                CornerType next = lastNext( current );
+                if (next == BORDER_CORNER || isAnchor( next ) || ++steps > maximumSteps)
+                {
+                    return false;
+                }
+                leftVertices.push_back( next );
+                current = next;
+            }
+            while (current != vertex);
+
+            std::sort( leftVertices.begin( ), leftVertices.end( ) );
+            removedLoops.push_back( vertex );
+        }
+    }
+
+    //Splice the changes into the loops.
+    for (CornerType vertex : removedLoops)
+    {
+        _borderLoops.erase( _loopOfVertex[vertex] );
+    }
+
+    for (const std::pair<CornerType, CornerType>& vertexAnchor : left)
+    {
+        auto loopIt = _borderLoops.find( _loopOfVertex[vertexAnchor.second] );
+        if (loopIt != _borderLoops.end( ) && loopIt->second == vertexAnchor.first)
+        {
+            loopIt->second = vertexAnchor.second;
+        }
+    }
+
+    for (CornerType vertex : leftVertices)
+    {
+        _loopOfVertex[vertex] = BORDER_CORNER;
+    }
+
+    for (const std::pair<CornerType, CornerType>& vertexAnchor : joined)
+    {
+        _loopOfVertex[vertexAnchor.first] = _loopOfVertex[vertexAnchor.second];
+    }
+
+    for (CornerType vertex : newLoops)
+    {
+        CornerType loop = _nextBorderLoopId++;
+        CornerType current = vertex;
+
+        do
+        {
+            _loopOfVertex[current] = loop;
+            current = getNextBorderVertex( current );
+        }
+        while (current != vertex);
+
+        _borderLoops[loop] = vertex;
+    }
+
+    return true;
+}
+
+
+
+template< class Storage >
+bool CornerTableT< Storage >::walkBorderLoops( )
+{
+    CornerType firstLoop = _nextBorderLoopId;
+
+    //Drop the loops through the changed vertices. Their other vertices are
+    //on the loops walked from the changed ones.
+    for (CornerType vertex : _dirtyBorderVertices)
+    {
+        _borderLoops.erase( _loopOfVertex[vertex] );
+        _loopOfVertex[vertex] = BORDER_CORNER;
+    }
+
+    for (CornerType vertex : _dirtyBorderVertices)
+    {
+        if (_loopOfVertex[vertex] != BORDER_CORNER || getNextBorderVertex( vertex ) == BORDER_CORNER)
+        {
+            continue;
+        }
+
+        CornerType loop = _nextBorderLoopId++;
+        CornerType current = vertex;
+
+        do
+        {
+            _loopOfVertex[current] = loop;
+
+            CornerType next = getNextBorderVertex( current );
+            if (next == BORDER_CORNER || _previousBorderVertex[next] != current)
+            {
+                return false;
+            }
+            current = next;
+        }
+        while (current != vertex && _loopOfVertex[current] < firstLoop);
+
+        if (current != vertex)
+        {
+            return false;
+        }
+
+        _borderLoops[loop] = vertex;
+    }
+
+    return true;
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::rebuildBorderLoops( )
+{
+    _borderCornerOfVertex.assign( _numberVertices, BORDER_CORNER );
+    _previousBorderVertex.assign( _numberVertices, BORDER_CORNER );
+    _loopOfVertex.assign( _numberVertices, BORDER_CORNER );
+    _lastNextBorderVertex.assign( _numberVertices, BORDER_CORNER );
+    _isDirtyBorderVertex.assign( _numberVertices, false );
+    _dirtyBorderVertices.clear( );
+    _borderLoops.clear( );
+    _nextBorderLoopId = 0;
+
+    for (CornerType corner = 0; corner < 3 * _numberTriangles; corner++)
+    {
+        addBorderCorner( corner );
+    }
+    clearDirtyBorderVertices( );
+
+    for (const std::vector<CornerType>& loop : computeBorderLoops( ))
+    {
+        CornerType loopId = _nextBorderLoopId++;
+        for (CornerType loopVertex : loop)
+        {
+            _loopOfVertex[loopVertex] = loopId;
+        }
+        _borderLoops[loopId] = loop.back( );
+    }
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::clearDirtyBorderVertices( )
+{
+    for (CornerType vertex : _dirtyBorderVertices)
+    {
+        _isDirtyBorderVertex[vertex] = false;
+    }
+    _dirtyBorderVertices.clear( );
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::markDirtyBorderVertex( const CornerType vertex )
+{
+    if (!_isDirtyBorderVertex[vertex])
+    {
+        _isDirtyBorderVertex[vertex] = true;
+        _lastNextBorderVertex[vertex] = getNextBorderVertex( vertex );
+        _dirtyBorderVertices.push_back( vertex );
+    }
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::beginBorderUpdate( std::initializer_list<CornerType> triangles )
+{
+    if (!_isTrackingBorder)
+    {
+        return;
+    }
+
+    _updatedBorderTriangles.clear( );
+
+    for (CornerType triangle : triangles)
+    {
+        if (triangle == BORDER_CORNER || triangle >= _numberTriangles)
+        {
+            continue;
+        }
+
+        _updatedBorderTriangles.push_back( triangle );
+
+        removeBorderCorner( 3 * triangle );
+        removeBorderCorner( 3 * triangle + 1 );
+        removeBorderCorner( 3 * triangle + 2 );
+    }
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::endBorderUpdate( std::initializer_list<CornerType> newTriangles )
+{
+    if (!_isTrackingBorder)
+    {
+        return;
+    }
+
+    resizeBorderTracking( );
+
+    _updatedBorderTriangles.insert( _updatedBorderTriangles.end( ), newTriangles );
+
+    for (CornerType triangle : _updatedBorderTriangles)
+    {
+        if (triangle == BORDER_CORNER || triangle >= _numberTriangles)
+        {
+            continue;
+        }
+
+        addBorderCorner( 3 * triangle );
+        addBorderCorner( 3 * triangle + 1 );
+        addBorderCorner( 3 * triangle + 2 );
+    }
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::resizeBorderTracking( )
+{
+    //New vertices are not on a loop yet.
+    if (_borderCornerOfVertex.size( ) < ( size_t ) _numberVertices)
+    {
+        _borderCornerOfVertex.resize( _numberVertices, BORDER_CORNER );
+        _previousBorderVertex.resize( _numberVertices, BORDER_CORNER );
+        _loopOfVertex.resize( _numberVertices, BORDER_CORNER );
+        _lastNextBorderVertex.resize( _numberVertices, BORDER_CORNER );
+        _isDirtyBorderVertex.resize( _numberVertices, false );
+    }
+}
+
+
+
+template< class Storage >
+CornerType CornerTableT< Storage >::findBorderCorner( const CornerType vertex ) const
+{
+    if (_isTrackingBorder)
+    {
+        return _borderCornerOfVertex[vertex];
+    }
+
+    //The star corners are on the triangles around the vertex.
+    for (CornerType neighbour : getCornerStar( _vertexToCorner[vertex] ))
+    {
+        CornerType triangle = cornerTriangle( neighbour );
+
+        for (CornerType corner = 3 * triangle; corner < 3 * triangle + 3; corner++)
+        {
+            if (_oppositeCorner[corner] == BORDER_CORNER && _cornerToVertex[cornerNext( corner )] == vertex &&
+                _cornerToVertex[cornerPrevious( corner )] != vertex)
+            {
+                return corner;
+            }
+        }
+    }
+
+    return BORDER_CORNER;
+}
+
+
+
+template< class Storage >
+bool CornerTableT< Storage >::stitchPatch( const CornerTableT& patch, const std::vector<CornerType>& boundary )
+{
+    CornerType numberBoundaryVertices = boundary.size( );
+    CornerType firstTriangle = _numberTriangles;
+    CornerType firstCorner = 3 * firstTriangle;
+    CornerType firstVertex = _numberVertices;
+
+    if (patch._numberVertices < numberBoundaryVertices)
+    {
+        return false;
+    }
+
+    //Border corner of the hole that starts on each boundary vertex.
+    std::vector<CornerType> holeCorners( numberBoundaryVertices );
+    for (CornerType i = 0; i < numberBoundaryVertices; i++)
+    {
+        holeCorners[i] = findBorderCorner( boundary[i] );
+    }
+
+    //The seam: the patch edge from a to b is opposite to the hole edge from
+    //b to a. Every edge is checked before the mesh is changed, so a patch
+    //that does not match the hole leaves the mesh as it was.
+    std::vector<CornerType> seamCorners( numberBoundaryVertices, BORDER_CORNER );
+
+    for (CornerType corner = 0; corner < 3 * patch._numberTriangles; corner++)
+    {
+        if (patch._oppositeCorner[corner] != BORDER_CORNER)
+        {
+            continue;
+        }
+
+        CornerType a = patch._cornerToVertex[patch.cornerNext( corner )];
+        CornerType b = patch._cornerToVertex[patch.cornerPrevious( corner )];
+
+        if (a >= numberBoundaryVertices || b >= numberBoundaryVertices || seamCorners[b] != BORDER_CORNER)
+        {
+            return false;
+        }
+
+        CornerType holeCorner = holeCorners[b];
+
+        if (holeCorner == BORDER_CORNER || _oppositeCorner[holeCorner] != BORDER_CORNER ||
+            _cornerToVertex[cornerPrevious( holeCorner )] != boundary[a])
+        {
+            return false;
+        }
+
+        seamCorners[b] = corner;
+    }
+
+    for (CornerType i = 0; i < numberBoundaryVertices; i++)
+    {
+        if (seamCorners[i] == BORDER_CORNER)
+        {
+            return false;
+        }
+    }
+
+    reserveVectors( _numberTriangles + patch._numberTriangles,
+                    _numberVertices + patch._numberVertices - numberBoundaryVertices );
+
+    //Vertices of the patch on this mesh.
+    auto meshVertex = [&] ( const CornerType patchVertex )
+    {
+        return patchVertex < numberBoundaryVertices ? boundary[patchVertex] :
+            firstVertex + patchVertex - numberBoundaryVertices;
+    };
+
+    for (CornerType patchVertex = numberBoundaryVertices; patchVertex < patch._numberVertices; patchVertex++)
+    {
+        for (unsigned int i = 0; i < _numberCoordinatesByVertex; i++)
+        {
+            _attributes.set( meshVertex( patchVertex ), i, patch._attributes.get( patchVertex, i ) );
+        }
+        _vertexToCorner[meshVertex( patchVertex )] = firstCorner + patch._vertexToCorner[patchVertex];
+    }
+
+    //Triangles and the opposites inside the patch.
+    for (CornerType corner = 0; corner < 3 * patch._numberTriangles; corner++)
+    {
+        _cornerToVertex[firstCorner + corner] = meshVertex( patch._cornerToVertex[corner] );
+        _oppositeCorner[firstCorner + corner] = patch._oppositeCorner[corner] == BORDER_CORNER ?
+            BORDER_CORNER : firstCorner + patch._oppositeCorner[corner];
+    }
+
+    _numberVertices += patch._numberVertices - numberBoundaryVertices;
+    _numberTriangles += patch._numberTriangles;
+
+    if (_isTrackingBorder)
+    {
+        resizeBorderTracking( );
+    }
+
+    for (CornerType b = 0; b < numberBoundaryVertices; b++)
+    {
+        CornerType holeCorner = holeCorners[b];
+
+        if (_isTrackingBorder)
+        {
+            removeBorderCorner( holeCorner );
+        }
+
+        _oppositeCorner[firstCorner + seamCorners[b]] = holeCorner;
+        _oppositeCorner[holeCorner] = firstCorner + seamCorners[b];
+    }
+
+    return true;
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::truncate( const CornerType numberTriangles, const CornerType numberVertices )
+{
+    assert( numberTriangles <= _numberTriangles && numberVertices <= _numberVertices );
+
+    CornerType firstRemovedCorner = 3 * numberTriangles;
+
+    //Kept corners opposite to the removed ones are border again.
+    for (CornerType corner = firstRemovedCorner; corner < 3 * _numberTriangles; corner++)
+    {
+        CornerType opposite = _oppositeCorner[corner];
+
+        if (opposite != BORDER_CORNER && opposite < firstRemovedCorner)
+        {
+            _oppositeCorner[opposite] = BORDER_CORNER;
+        }
+    }
 
-    //Allocate the vectors.
-    _cornerToVertex = std::vector<CornerType>( 3 * numberTriangles );
-    _vertexToCorner = std::vector<CornerType>( numberVertices );
-    _oppositeCorner = std::vector<CornerType>( 3 * numberTriangles );
-    _attributes = std::vector<double>( numberCoordinatesByVertex * numberVertices );
+    _nonManifoldCorners.erase( std::lower_bound( _nonManifoldCorners.begin( ), _nonManifoldCorners.end( ),
+                                                 firstRemovedCorner ), _nonManifoldCorners.end( ) );
 
-    //Coppy the informations.
-    memcpy( &_cornerToVertex[0], triangleList, 3 * numberTriangles * sizeof (CornerType ) );
-    memcpy( &_attributes[0], vertexList, numberCoordinatesByVertex * numberVertices * sizeof ( double ) );
+    _numberTriangles = numberTriangles;
+    _numberVertices = numberVertices;
 
-    //Initialize vectors
-    memset( &_vertexToCorner[0], 0, numberVertices * sizeof (CornerType ) );
-    for (CornerType i = 0; i < 3 * _numberTriangles; i++)
+    if (_isTrackingBorder)
     {
-        _oppositeCorner[i] = BORDER_CORNER;
+        rebuildBorderLoops( );
     }
-
-    //Build the opposite table.
-    buildOppositeTable( );
 }
 
 
 
-CornerTable::~CornerTable( )
+template< class Storage >
+void CornerTableT< Storage >::removeBorderCorner( const CornerType corner )
 {
-}
+    CornerType from = _cornerToVertex[cornerNext( corner )];
+    CornerType to = _cornerToVertex[cornerPrevious( corner )];
 
+    if (_oppositeCorner[corner] != BORDER_CORNER || from == to)
+    {
+        return;
+    }
 
+    markDirtyBorderVertex( from );
+    markDirtyBorderVertex( to );
 
-unsigned int CornerTable::getNumberAttributesByVertex( ) const
-{
-    return _numberCoordinatesByVertex;
+    if (_borderCornerOfVertex[from] == corner)
+    {
+        _borderCornerOfVertex[from] = BORDER_CORNER;
+    }
+
+    if (_previousBorderVertex[to] == from)
+    {
+        _previousBorderVertex[to] = BORDER_CORNER;
+    }
 }
 
 
 
-CornerType CornerTable::getNumberVertices( ) const
+template< class Storage >
+void CornerTableT< Storage >::addBorderCorner( const CornerType corner )
 {
-    return _numberVertices;
-}
+    CornerType from = _cornerToVertex[cornerNext( corner )];
+    CornerType to = _cornerToVertex[cornerPrevious( corner )];
 
+    if (_oppositeCorner[corner] != BORDER_CORNER || from == to)
+    {
+        return;
+    }
 
+    markDirtyBorderVertex( from );
+    markDirtyBorderVertex( to );
 
-CornerType CornerTable::getNumTriangles( ) const
-{
-    return _numberTriangles;
+    _borderCornerOfVertex[from] = corner;
+    _previousBorderVertex[to] = from;
 }
 
 
 
-double* CornerTable::getAttributes( ) const
+template< class Storage >
+void CornerTableT< Storage >::setParallelBuildThreshold( const CornerType numberCorners )
 {
-    return ( double* ) ( &_attributes[0] );
+    parallelBuildThreshold = numberCorners;
 }
 
 
 
-CornerType CornerTable::cornerToVertexIndex( const CornerType corner ) const
+template< class Storage >
+void CornerTableT< Storage >::setReallocationFactor( const unsigned int reallocationFactor )
 {
-    return _cornerToVertex[corner];
+    if (reallocationFactor > 1)
+    {
+        _reallocationFactor = reallocationFactor;
+    }
 }
 
 
 
-CornerType CornerTable::vertexToCornerIndex( const CornerType vertex ) const
+template< class Storage >
+unsigned int CornerTableT< Storage >::getReallocationFactor( ) const
 {
-    return _vertexToCorner[ vertex ];
+    return _reallocationFactor;
 }
 
 
 
-const CornerType* CornerTable::getTriangleList( ) const
+template< class Storage >
+void CornerTableT< Storage >::reserve( const CornerType numberTriangles, const CornerType numberVertices )
 {
-    return &_cornerToVertex[0];
+    //The operations reallocate before they reach the allocated size.
+    reserveVectors( numberTriangles + 1, numberVertices + 1 );
 }
 
 
-
-void CornerTable::setReallocationFactor( const unsigned int reallocationFactor )
+template< class Storage >
+void CornerTableT< Storage >::triangleSplit( const CornerType triangle, const double* coordinates )
 {
-    if (reallocationFactor > 1)
+    if (triangle == BORDER_CORNER || triangle >= _numberTriangles)
     {
-        _reallocationFactor = reallocationFactor;
+        return;
     }
-}
 
+    //Resize the vectors if it is necessary.
+    resizeVectors( );
 
+    //Identify the incidences.
+    CornerType c0 = 3 * triangle;
+    CornerType c1 = c0 + 1;
+    CornerType c2 = c0 + 2;
+    CornerType o0 = _oppositeCorner[c0];
+    CornerType o1 = _oppositeCorner[c1];
 
-unsigned int CornerTable::getReallocationFactor( ) const
-{
-    return _reallocationFactor;
-}
+    //Get the vertices corner.
+    CornerType a = _cornerToVertex[c0];
+    CornerType b = _cornerToVertex[c1];
+    CornerType c = _cornerToVertex[c2];
+
+    beginBorderUpdate( { triangle } );
+
+    //Get the index of the new vertex.
+    CornerType indexNewPoint = _numberVertices;
+
+    //Copy the vertex coordinates to attributes vector.
+    for (unsigned int i = 0; i < _numberCoordinatesByVertex; i++)
+    {
+        _attributes.set( indexNewPoint, i, ( ScalarType ) coordinates[i] );
+    }
+    _numberVertices++;
+
+    //Get indexes of the new triangles.
+    CornerType triangleAIndex = _numberTriangles;
+    CornerType triangleBIndex = _numberTriangles + 1;
+    _numberTriangles += 2;
+
+    //The triangle keeps the edge (a, b), the new ones take (b, c) and (c, a).
+    _cornerToVertex[c2] = indexNewPoint;
 
+    _cornerToVertex[3 * triangleAIndex + 0] = b;
+    _cornerToVertex[3 * triangleAIndex + 1] = c;
+    _cornerToVertex[3 * triangleAIndex + 2] = indexNewPoint;
+
+    _cornerToVertex[3 * triangleBIndex + 0] = c;
+    _cornerToVertex[3 * triangleBIndex + 1] = a;
+    _cornerToVertex[3 * triangleBIndex + 2] = indexNewPoint;
+
+    //Save corners to vertex.
+    _vertexToCorner[indexNewPoint] = c2;
+    _vertexToCorner[c] = 3 * triangleAIndex + 1;
+
+    //Update the opposite table.
+    _oppositeCorner[c0] = 3 * triangleAIndex + 1;
+    _oppositeCorner[3 * triangleAIndex + 1] = c0;
+
+    _oppositeCorner[c1] = 3 * triangleBIndex;
+    _oppositeCorner[3 * triangleBIndex] = c1;
+
+    _oppositeCorner[3 * triangleAIndex] = 3 * triangleBIndex + 1;
+    _oppositeCorner[3 * triangleBIndex + 1] = 3 * triangleAIndex;
+
+    _oppositeCorner[3 * triangleAIndex + 2] = o0;
+    if (o0 != BORDER_CORNER)
+    {
+        _oppositeCorner[o0] = 3 * triangleAIndex + 2;
+    }
+
+    _oppositeCorner[3 * triangleBIndex + 2] = o1;
+    if (o1 != BORDER_CORNER)
+    {
+        _oppositeCorner[o1] = 3 * triangleBIndex + 2;
+    }
+
+    endBorderUpdate( { triangleAIndex, triangleBIndex } );
+}
 
 
-bool CornerTable::edgeFlip( const CornerType corner )
+template< class Storage >
+bool CornerTableT< Storage >::edgeFlip( const CornerType corner )
 {
     if (corner == BORDER_CORNER || _oppositeCorner[corner] == BORDER_CORNER)
     {
@@ -143,6 +1152,8 @@ bool CornerTable::edgeFlip( const CornerType corner )
     CornerType s = _cornerToVertex[c3];
 
     assert( t!=u && t!=v && t!=s && u!=v && u!=s && v!=s );
+
+    beginBorderUpdate( { cornerTriangle( corner ), cornerTriangle( c3 ) } );
     
     //Change the triangulation.
     _cornerToVertex[c5] = t;
@@ -169,12 +1180,15 @@ bool CornerTable::edgeFlip( const CornerType corner )
     {
         _oppositeCorner[c] = corner;
     }
+
+    endBorderUpdate( { } );
     return true;
 }
 
 
 
-bool CornerTable::edgeUnflip( const CornerType corner )
+template< class Storage >
+bool CornerTableT< Storage >::edgeUnflip( const CornerType corner )
 {
     if (corner < 0 || _oppositeCorner[corner] == BORDER_CORNER)
     {
@@ -197,6 +1211,8 @@ bool CornerTable::edgeUnflip( const CornerType corner )
     CornerType s = _cornerToVertex[c2];
     CornerType t = _cornerToVertex[c0];
 
+    beginBorderUpdate( { cornerTriangle( corner ), cornerTriangle( c4 ) } );
+
     //Change the triangulation.
     _cornerToVertex[c5] = v;
     _cornerToVertex[c2] = u;
@@ -221,12 +1237,15 @@ bool CornerTable::edgeUnflip( const CornerType corner )
     {
         _oppositeCorner[c] = c4;
     }
+
+    endBorderUpdate( { } );
     return true;
 }
 
 
 
-void CornerTable::edgeSplit( const CornerType corner, const double* coordinates )
+template< class Storage >
+void CornerTableT< Storage >::edgeSplit( const CornerType corner, const double* coordinates )
 {
     if (corner < 0 || corner == BORDER_CORNER)
     {
@@ -258,13 +1277,15 @@ void CornerTable::edgeSplit( const CornerType corner, const double* coordinates
         a = _oppositeCorner[c5];
     }
 
+    beginBorderUpdate( { cornerTriangle( corner ), c3 != BORDER_CORNER ? cornerTriangle( c3 ) : BORDER_CORNER } );
+
     //Get the index of the new vertex.
     CornerType indexNewPoint = _numberVertices;
 
     //Copy the vertex coordinates to attributes vector.
     for (unsigned int i = 0; i < _numberCoordinatesByVertex; i++)
     {
-        _attributes[_numberCoordinatesByVertex * indexNewPoint + i ] = coordinates[i];
+        _attributes.set( indexNewPoint, i, ( ScalarType ) coordinates[i] );
     }
     _numberVertices++;
 
@@ -333,11 +1354,14 @@ void CornerTable::edgeSplit( const CornerType corner, const double* coordinates
     {
         _oppositeCorner[a] = 3 * triangleBIndex + 2;
     }
+
+    endBorderUpdate( { triangleAIndex, c3 != BORDER_CORNER ? triangleBIndex : BORDER_CORNER } );
 }
 
 
 
-void CornerTable::edgeWeld( const CornerType corner )
+template< class Storage >
+void CornerTableT< Storage >::edgeWeld( const CornerType corner )
 {
     //Identify the incidences.
     CornerType c2 = cornerNext( corner );
@@ -363,6 +1387,16 @@ void CornerTable::edgeWeld( const CornerType corner )
         d = _oppositeCorner[ cornerNext( c7 ) ];
     }
 
+    //The triangles that shift out of the count are changed as well.
+    auto triangleOf = [this] ( const CornerType c )
+    {
+        return c != BORDER_CORNER ? cornerTriangle( c ) : BORDER_CORNER;
+    };
+    beginBorderUpdate( { cornerTriangle( corner ), triangleOf( c7 ), triangleOf( c3 ),
+                         c5 != BORDER_CORNER ? triangleOf( _oppositeCorner[c5] ) : BORDER_CORNER,
+                         triangleOf( _oppositeCorner[c0] ), triangleOf( a ), triangleOf( d ),
+                         _numberTriangles - 1, _numberTriangles - 2 } );
+
     if (c4 != BORDER_CORNER)
     {
         CornerType u = _cornerToVertex[c2];
@@ -432,11 +1466,14 @@ void CornerTable::edgeWeld( const CornerType corner )
         CornerType s = _cornerToVertex[corner];
         _vertexToCorner[s] = _oppositeCorner[corner];
     }
+
+    endBorderUpdate( { } );
 }
 
 
 
-int CornerTable::edgeOriented( const CornerType corner, double* coordinate )
+template< class Storage >
+int CornerTableT< Storage >::edgeOriented( const CornerType corner, double* coordinate )
 {
     double X = coordinate[0];
     double Y = coordinate[1];
@@ -447,10 +1484,10 @@ int CornerTable::edgeOriented( const CornerType corner, double* coordinate )
     int v0 = cornerToVertexIndex( c0 );
     int v1 = cornerToVertexIndex( c1 );
     
-    double Ax = getAttributes()[ _numberCoordinatesByVertex * v0 ];
-    double Ay = getAttributes()[ _numberCoordinatesByVertex * v0 + 1 ];
-    double Bx = getAttributes()[ _numberCoordinatesByVertex * v1 ];
-    double By = getAttributes()[ _numberCoordinatesByVertex * v1 + 1 ];
+    double Ax = _attributes.get( v0, 0 );
+    double Ay = _attributes.get( v0, 1 );
+    double Bx = _attributes.get( v1, 0 );
+    double By = _attributes.get( v1, 1 );
     
     double orientation = (Bx - Ax) * (Y - Ay) - (By - Ay) * (X - Ax);
     return (orientation < 0) ? -1 : (orientation > 0) ? 1 : 0; 
@@ -458,7 +1495,8 @@ int CornerTable::edgeOriented( const CornerType corner, double* coordinate )
 
 
 
-double CornerTable::edgeLength( const CornerType corner )
+template< class Storage >
+double CornerTableT< Storage >::edgeLength( const CornerType corner )
 {
     int c0 = cornerPrevious( corner );
     int c1 = cornerNext( corner );
@@ -471,31 +1509,32 @@ double CornerTable::edgeLength( const CornerType corner )
         std::cout << "sumfin wrong\n";
     }
     
-    double Ax = getAttributes()[ _numberCoordinatesByVertex * v0 ];
-    double Ay = getAttributes()[ _numberCoordinatesByVertex * v0 + 1 ];
-    double Az = getAttributes()[ _numberCoordinatesByVertex * v0 + 2 ];
-    double Bx = getAttributes()[ _numberCoordinatesByVertex * v1 ];
-    double By = getAttributes()[ _numberCoordinatesByVertex * v1 + 1 ];
-    double Bz = getAttributes()[ _numberCoordinatesByVertex * v1 + 2 ];
+    double Ax = _attributes.get( v0, 0 );
+    double Ay = _attributes.get( v0, 1 );
+    double Az = _attributes.get( v0, 2 );
+    double Bx = _attributes.get( v1, 0 );
+    double By = _attributes.get( v1, 1 );
+    double Bz = _attributes.get( v1, 2 );
     
     return sqrt( (Ax - Bx)*(Ax - Bx) + (Ay - By)*(Ay - By) + (Az - Bz)*(Az - Bz) );
 }
 
 
 
-void CornerTable::edgeMidpoint( const CornerType corner, double& x, double& y, double& z )
+template< class Storage >
+void CornerTableT< Storage >::edgeMidpoint( const CornerType corner, double& x, double& y, double& z )
 {
     int c0 = cornerPrevious( corner );
     int c1 = cornerNext( corner );
     int v0 = cornerToVertexIndex( c0 );
     int v1 = cornerToVertexIndex( c1 );
     
-    double Ax = getAttributes()[ _numberCoordinatesByVertex * v0 ];
-    double Ay = getAttributes()[ _numberCoordinatesByVertex * v0 + 1 ];
-    double Az = getAttributes()[ _numberCoordinatesByVertex * v0 + 2 ];
-    double Bx = getAttributes()[ _numberCoordinatesByVertex * v1 ];
-    double By = getAttributes()[ _numberCoordinatesByVertex * v1 + 1 ];
-    double Bz = getAttributes()[ _numberCoordinatesByVertex * v1 + 2 ];
+    double Ax = _attributes.get( v0, 0 );
+    double Ay = _attributes.get( v0, 1 );
+    double Az = _attributes.get( v0, 2 );
+    double Bx = _attributes.get( v1, 0 );
+    double By = _attributes.get( v1, 1 );
+    double Bz = _attributes.get( v1, 2 );
     
     x = (Ax + Bx)/2;
     y = (Ay + By)/2;
@@ -504,25 +1543,29 @@ void CornerTable::edgeMidpoint( const CornerType corner, double& x, double& y, d
 
 
 
-double CornerTable::getVertexAverageEdgeLength( const CornerType vertex )
+template< class Storage >
+double CornerTableT< Storage >::getVertexAverageEdgeLength( const CornerType vertex )
 {
     double average = 0;
+    CornerType count = 0;
     CornerType corner = vertexToCornerIndex( vertex );
-    auto neighbours = getCornerNeighbours( corner );
-    neighbours.push_back( corner );
-    
-    for( auto neighbour : neighbours )
+
+    forEachCornerNeighbour( corner, [this, &average, &count] ( const CornerType neighbour )
     {
-        CornerType next = cornerNext( neighbour );
-        average += edgeLength( next );
-    }
-    
-    return average / neighbours.size();
+        average += edgeLength( cornerNext( neighbour ) );
+        count++;
+    } );
+
+    average += edgeLength( cornerNext( corner ) );
+    count++;
+
+    return average / count;
 }
 
 
 
-bool CornerTable::areEdgeTrianglesInCircumsphere( const CornerType corner )
+template< class Storage >
+bool CornerTableT< Storage >::areEdgeTrianglesInCircumsphere( const CornerType corner )
 {
     CornerType opp = cornerOpposite( corner );
     
@@ -542,12 +1585,12 @@ bool CornerTable::areEdgeTrianglesInCircumsphere( const CornerType corner )
     CornerType v1 = cornerToVertexIndex( corner );
     CornerType v2 = cornerToVertexIndex( opp );
     
-    double x1 = getAttributes()[ 3 * v1 ];
-    double y1 = getAttributes()[ 3 * v1 + 1 ];
-    double z1 = getAttributes()[ 3 * v1 + 2 ];
-    double x2 = getAttributes()[ 3 * v2 ];
-    double y2 = getAttributes()[ 3 * v2 + 1 ];
-    double z2 = getAttributes()[ 3 * v2 + 2 ];
+    double x1 = _attributes.get( v1, 0 );
+    double y1 = _attributes.get( v1, 1 );
+    double z1 = _attributes.get( v1, 2 );
+    double x2 = _attributes.get( v2, 0 );
+    double y2 = _attributes.get( v2, 1 );
+    double z2 = _attributes.get( v2, 2 );
     
     double d1 = sqrt( (x1 - x)*(x1 - x) + (y1 - y)*(y1 - y) + (z1 - z)*(z1 - z) );
     double d2 = sqrt( (x2 - x)*(x2 - x) + (y2 - y)*(y2 - y) + (z2 - z)*(z2 - z) );
@@ -557,84 +1600,321 @@ bool CornerTable::areEdgeTrianglesInCircumsphere( const CornerType corner )
 
 
 
-void CornerTable::buildOppositeTable( )
+template< class Storage >
+void CornerTableT< Storage >::computeEdgeLengths( std::vector< double >& edgeLengths ) const
+{
+    edgeLengths.resize( 3 * _numberTriangles );
+
+    if (_numberTriangles == 0)
+    {
+        return;
+    }
+
+    GeometryKernels::computeEdgeLengths( &_cornerToVertex[0], _numberTriangles, _attributes.getCoordinate( 0 ),
+                                         _attributes.getCoordinate( 1 ), _attributes.getCoordinate( 2 ),
+                                         _attributes.getStride( ), &edgeLengths[0] );
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::computeVertexAverageEdgeLengths( const std::vector< double >& edgeLengths,
+                                                               std::vector< double >& averages ) const
+{
+    averages.assign( _numberVertices, 0 );
+
+    if (_numberTriangles == 0)
+    {
+        return;
+    }
+
+    //Same traverse and summation order of getCornerNeighbours and
+    //getVertexAverageEdgeLength.
+    #pragma omp parallel for schedule(static)
+    for (CornerType vertex = 0; vertex < _numberVertices; vertex++)
+    {
+        CornerType corner = _vertexToCorner[vertex];
+        double sum = 0;
+        CornerType count = 0;
+
+        forEachCornerNeighbour( corner, [this, &edgeLengths, &sum, &count] ( const CornerType neighbour )
+        {
+            sum += edgeLengths[cornerNext( neighbour )];
+            count++;
+        } );
+
+        //The corner of the vertex itself.
+        sum += edgeLengths[cornerNext( corner )];
+        count++;
+
+        averages[vertex] = sum / count;
+    }
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::computeFaceAreasAndNormals( std::vector< double >& areas,
+                                                          std::vector< double >& normals ) const
+{
+    areas.resize( _numberTriangles );
+    normals.resize( 3 * _numberTriangles );
+
+    if (_numberTriangles == 0)
+    {
+        return;
+    }
+
+    GeometryKernels::computeFaceAreasAndNormals( &_cornerToVertex[0], _numberTriangles,
+                                                 _attributes.getCoordinate( 0 ), _attributes.getCoordinate( 1 ),
+                                                 _attributes.getCoordinate( 2 ), _attributes.getStride( ),
+                                                 &areas[0], &normals[0] );
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::buildOppositeTable( )
+{
+    _nonManifoldCorners.clear( );
+
+    if (omp_get_max_threads( ) > 1 && 3 * _numberTriangles >= parallelBuildThreshold)
+    {
+        buildOppositeTableParallel( );
+    }
+    else
+    {
+        buildOppositeTableSerial( );
+    }
+
+    buildVertexToCornerTable( );
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::buildOppositeTableSerial( )
 {
-    //The adjacency list from corner to vetices.
-    std::vector< std::list< CornerType > > cornersInVertices;
+    CornerType totalCorners = 3 * _numberTriangles;
+
+    //Open addressing hash table from the directed edge opposite to a corner to
+    //the corner. Its size is a power of two at least twice the number of
+    //corners, so the probe sequences stay short.
+    unsigned int hashBits = 4;
+    while (( ( size_t ) 1 << hashBits ) < 2 * ( size_t ) totalCorners)
+    {
+        hashBits++;
+    }
 
-    //Allocate memory for the adjacency list.
-    cornersInVertices.resize( _numberVertices );
-    for (CornerType corner = 0, totalCorners = 3 * _numberTriangles; corner < totalCorners; corner++)
+    size_t hashMask = ( ( size_t ) 1 << hashBits ) - 1;
+    std::vector< EdgeSlot > edgeHash( hashMask + 1 );
+
+    //Return the slot of a key, or the empty slot where it would be inserted.
+    auto findSlot = [&edgeHash, hashBits, hashMask] ( const uint64_t key ) -> EdgeSlot&
     {
-        //Get the vertex of the corner.
-        CornerType vertex = _cornerToVertex[corner];
+        size_t slot = edgeHashSlot( key, hashBits );
+
+        while (edgeHash[slot].key != EdgeSlot::EMPTY_KEY && edgeHash[slot].key != key)
+        {
+            slot = ( slot + 1 ) & hashMask;
+        }
 
-        //Add the corner at the vertex list.
-        cornersInVertices[vertex].push_back( corner );
+        return edgeHash[slot];
+    };
+
+    //Insert the edges. A directed edge that appears more than once is marked
+    //as repeated.
+    for (CornerType corner = 0; corner < totalCorners; corner++)
+    {
+        uint64_t key = edgeKey( _cornerToVertex[cornerNext( corner )], _cornerToVertex[cornerPrevious( corner )] );
+        EdgeSlot& edge = findSlot( key );
 
-        //Update the vector that store a corner to each vertex.
-        _vertexToCorner[vertex] = corner;
+        if (edge.key == EdgeSlot::EMPTY_KEY)
+        {
+            edge.key = key;
+            edge.corner = corner;
+        }
+        else
+        {
+            edge.isRepeated = true;
+        }
     }
 
     //Compute the opposite corner to each corner.
-    for (CornerType i = 0; i < _numberTriangles; i++)
+    for (CornerType corner = 0; corner < totalCorners; corner++)
     {
-        for (int j = 0; j < 3; j++)
+        //Verify if the opposite corner was already computed.
+        if (_oppositeCorner[corner] != BORDER_CORNER)
         {
-            CornerType corner = 3 * i + j;
+            continue;
+        }
 
-            //Verifica se o oposto do corner eh BORDER_CORNER. Se nao for e o caso de ja
-            //ter calculado seu corner oposto
-            if (_oppositeCorner[corner] == BORDER_CORNER)
-            {
-                //Compute opposite corner analyzing the opposite edge.
-                CornerType vertexNext = _cornerToVertex[cornerNext( corner )];
-                CornerType vertexPrevious = _cornerToVertex[cornerPrevious( corner )];
+        //A degenerated edge has no opposite.
+        CornerType vertexNext = _cornerToVertex[cornerNext( corner )];
+        CornerType vertexPrevious = _cornerToVertex[cornerPrevious( corner )];
+        if (vertexNext == vertexPrevious)
+        {
+            continue;
+        }
 
-                //Initialize the opposite edge.
-                CornerType opposite = BORDER_CORNER;
+        //The opposite corner sees the same edge in the reverse direction. If
+        //there is no such edge, then the opposite edge is a border edge.
+        const EdgeSlot& reverse = findSlot( edgeKey( vertexPrevious, vertexNext ) );
+        const EdgeSlot& own = findSlot( edgeKey( vertexNext, vertexPrevious ) );
 
-                //Search by the opposite corner.
-                for (std::list<CornerType>::iterator it =
-                     cornersInVertices[vertexPrevious].begin( ); it != cornersInVertices[vertexPrevious].end( ); ++it)
-                {
-                    //Get one of the corners of the vertice.
-                    CornerType cornerOfVertexPrevious = *it;
+        //If any direction of the edge is repeated, the edge has more than two
+        //triangles or two triangles with the same orientation.
+        if (own.isRepeated || ( reverse.key != EdgeSlot::EMPTY_KEY && reverse.isRepeated ))
+        {
+            _nonManifoldCorners.push_back( corner );
+            continue;
+        }
+
+        if (reverse.key == EdgeSlot::EMPTY_KEY)
+        {
+            continue;
+        }
 
-                    //Get the next corner.
-                    CornerType nextCorner = cornerNext( cornerOfVertexPrevious );
+        //Update the opposite corner.
+        _oppositeCorner[corner] = reverse.corner;
+        _oppositeCorner[reverse.corner] = corner;
+    }
+}
 
-                    //Verify if find out the opposite face.
-                    if (_cornerToVertex[nextCorner] == vertexNext)
-                    {
-                        //get the opposite corner.
-                        opposite = cornerPrevious( cornerOfVertexPrevious );
-                        break;
-                    }
-                }
 
-                //If the opposite corner is BORDER_CORNER, then the opposite
-                //edge is a border edge.
-                if (opposite == BORDER_CORNER)
-                {
-                    //Update the table that stores a corner to each vextex such
-                    //that to turn each traverse to the border.
-                    _vertexToCorner[vertexNext] = cornerNext( corner );
-                    continue;
-                }
 
-                //Update the opposite corner.
-                _oppositeCorner[corner] = opposite;
-                _oppositeCorner[opposite] = corner;
+template< class Storage >
+void CornerTableT< Storage >::buildOppositeTableParallel( )
+{
+    CornerType totalCorners = 3 * _numberTriangles;
+
+    //The key of the undirected edge in front of each corner. It is
+    //min * n + max, so it needs ceil(log2(n^2)) bits.
+    uint64_t numberVertices = _numberVertices;
+    unsigned int keyBits = 1;
+    while (keyBits < 64 && ( ( uint64_t ) 1 << keyBits ) < numberVertices * numberVertices)
+    {
+        keyBits++;
+    }
+
+    std::vector< uint64_t > keys( totalCorners );
+    std::vector< CornerType > corners( totalCorners );
+
+    #pragma omp parallel for schedule(static)
+    for (CornerType corner = 0; corner < totalCorners; corner++)
+    {
+        uint64_t vertexNext = _cornerToVertex[cornerNext( corner )];
+        uint64_t vertexPrevious = _cornerToVertex[cornerPrevious( corner )];
+
+        keys[corner] = std::min( vertexNext, vertexPrevious ) * numberVertices +
+            std::max( vertexNext, vertexPrevious );
+        corners[corner] = corner;
+    }
+
+    radixSortEdgeKeys( keys, corners, keyBits );
+
+    //Pair the corners of each run of equal keys. The sort is stable, so the
+    //corners of a run are in increasing order.
+    std::vector< std::vector< CornerType > > nonManifoldByThread( omp_get_max_threads( ) );
+
+    #pragma omp parallel
+    {
+        std::vector< CornerType >& nonManifold = nonManifoldByThread[omp_get_thread_num( )];
+
+        #pragma omp for schedule(static)
+        for (CornerType begin = 0; begin < totalCorners; begin++)
+        {
+            //Only the first position of a run handles it.
+            if (begin > 0 && keys[begin] == keys[begin - 1])
+            {
+                continue;
             }
+
+            CornerType end = begin + 1;
+            while (end < totalCorners && keys[end] == keys[begin])
+            {
+                end++;
+            }
+
+            CornerType first = corners[begin];
+
+            //A single corner is a border, and so is a degenerated edge.
+            if (end - begin == 1 ||
+                _cornerToVertex[cornerNext( first )] == _cornerToVertex[cornerPrevious( first )])
+            {
+                continue;
+            }
+
+            //Two corners are opposite if they see the edge in reverse
+            //directions.
+            CornerType second = corners[begin + 1];
+            if (end - begin == 2 &&
+                _cornerToVertex[cornerNext( first )] == _cornerToVertex[cornerPrevious( second )])
+            {
+                _oppositeCorner[first] = second;
+                _oppositeCorner[second] = first;
+                continue;
+            }
+
+            nonManifold.insert( nonManifold.end( ), corners.begin( ) + begin, corners.begin( ) + end );
+        }
+    }
+
+    for (const std::vector< CornerType >& nonManifold : nonManifoldByThread)
+    {
+        _nonManifoldCorners.insert( _nonManifoldCorners.end( ), nonManifold.begin( ), nonManifold.end( ) );
+    }
+
+    std::sort( _nonManifoldCorners.begin( ), _nonManifoldCorners.end( ) );
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::buildVertexToCornerTable( )
+{
+    CornerType totalCorners = 3 * _numberTriangles;
+
+    //Update the vector that store a corner to each vertex.
+    for (CornerType corner = 0; corner < totalCorners; corner++)
+    {
+        _vertexToCorner[_cornerToVertex[corner]] = corner;
+    }
+
+    //Turn the traverse of each vertex on the border to start on the border.
+    for (CornerType corner = 0; corner < totalCorners; corner++)
+    {
+        if (_oppositeCorner[corner] == BORDER_CORNER)
+        {
+            _vertexToCorner[_cornerToVertex[cornerNext( corner )]] = cornerNext( corner );
         }
     }
+}
+
+
+
+template< class Storage >
+void CornerTableT< Storage >::reserveVectors( const CornerType numberTriangles, const CornerType numberVertices )
+{
+    if (numberTriangles > _maximumTriangles)
+    {
+        _maximumTriangles = std::max( numberTriangles, ( CornerType ) _reallocationFactor * _maximumTriangles );
+        _cornerToVertex.resize( 3 * _maximumTriangles );
+        _oppositeCorner.resize( 3 * _maximumTriangles );
+    }
 
+    if (numberVertices > _maximumPoints)
+    {
+        _maximumPoints = std::max( numberVertices, ( CornerType ) _reallocationFactor * _maximumPoints );
+        _attributes.resize( _maximumPoints );
+        _vertexToCorner.resize( _maximumPoints );
+    }
 }
 
 
 
-void CornerTable::resizeVectors( )
+template< class Storage >
+void CornerTableT< Storage >::resizeVectors( )
 {
     //Verify if it is necessary to allocate more space.
     if (_numberTriangles + 1 >= _maximumTriangles)
@@ -652,7 +1932,7 @@ void CornerTable::resizeVectors( )
     if (_numberVertices == _maximumPoints)
     {
         //Allocate more memory for the vertex list.
-        _attributes.resize( _reallocationFactor * _numberCoordinatesByVertex * _numberVertices );
+        _attributes.resize( _reallocationFactor * _numberVertices );
 
         //Allocate more memory for the the vector that stores a corner to each
         //vertex.
@@ -665,41 +1945,16 @@ void CornerTable::resizeVectors( )
 
 
 
-const std::vector<CornerType> CornerTable::getCornerNeighbours( const CornerType corner ) const
+template< class Storage >
+const std::vector<CornerType> CornerTableT< Storage >::getCornerNeighbours( const CornerType corner ) const
 {
     //Vector to stores the neighbor corner.
     std::vector<CornerType> neighboursCorners;
 
-    //Get the firt corner on the list.
-    CornerType firstCorner = cornerNext( corner );
-
-    //Run the loop until find the border or the first corner.
-    CornerType currentCorner = firstCorner;
-    do
-    {
-        //Add the current corner on list.
-        neighboursCorners.push_back( currentCorner );
-
-        //Get the next corner on right direction.
-        currentCorner = cornerRight( currentCorner );
-    }
-    while (currentCorner != BORDER_CORNER && currentCorner != firstCorner);
-
-    // If the search stopped on the first corner return the list.
-    if (currentCorner != BORDER_CORNER)
-        return neighboursCorners;
-
-    //Otherwise, continue on the left direction.
-    currentCorner = cornerPrevious( corner );
-    do
+    forEachCornerNeighbour( corner, [&neighboursCorners] ( const CornerType neighbour )
     {
-        //Add the current corner on list.
-        neighboursCorners.push_back( currentCorner );
-
-        //Get the next corner on left direction.
-        currentCorner = cornerLeft( currentCorner );
-    }
-    while (currentCorner != BORDER_CORNER);
+        neighboursCorners.push_back( neighbour );
+    } );
 
     //Return the neighbor list.
     return neighboursCorners;
@@ -707,7 +1962,8 @@ const std::vector<CornerType> CornerTable::getCornerNeighbours( const CornerType
 
 
 
-CornerType CornerTable::computeEulerCharacteristic( )
+template< class Storage >
+CornerType CornerTableT< Storage >::computeEulerCharacteristic( )
 {
     //Variaveis para contar numero de arestas da malha.
     CornerType numberBorderEdges = 0, numberInsideEdges = 0;
@@ -734,7 +1990,8 @@ CornerType CornerTable::computeEulerCharacteristic( )
 
 
 
-void CornerTable::printTriangleList( )
+template< class Storage >
+void CornerTableT< Storage >::printTriangleList( )
 {
     for (CornerType i = 0; i < _numberTriangles; i++)
     {
@@ -743,3 +2000,10 @@ void CornerTable::printTriangleList( )
     }
     printf( "\n\n" );
 }
+
+
+
+template class CornerTableT< InterleavedStorage< double > >;
+template class CornerTableT< InterleavedStorage< float > >;
+template class CornerTableT< PlanarStorage< double > >;
+template class CornerTableT< PlanarStorage< float > >;
@@ -3,17 +3,32 @@
 
 #include <vector>
 #include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <initializer_list>
+#include <type_traits>
 //#include "DefinitionTypes.h"
 
 typedef int CornerType;
+
+#include "VertexStorage.h"
     
-/**@class CornerTable
+/**@class CornerTableT
  * Topological data structure to store a triangle mesh and to allow perform
- * necessary topological operations.
+ * necessary topological operations. The Storage policy chooses the precision
+ * and the layout of the vertex attributes (InterleavedStorage or
+ * PlanarStorage). CornerTable is the double precision interleaved one.
  */
-class CornerTable
+template< class Storage >
+class CornerTableT
 {
 public:
+    /**
+     * Type of the vertex attributes.
+     */
+    typedef typename Storage::ScalarType ScalarType;
         
     /**
      * Constructor to mount the Corner Table topological data structure. This
@@ -32,13 +47,41 @@ public:
      * stored the vertex normal together with its coordinates. In this case, this
      * parameter will be 6 instead of 3.
      */
-    CornerTable( const CornerType *triangleList, double *vertexList, const CornerType numberTriangles,
+    CornerTableT( const CornerType *triangleList, double *vertexList, const CornerType numberTriangles,
         const CornerType numberVertices, const unsigned int numberCoordinatesByVertex );
 
+    /**
+     * Constructor that takes ownership of already filled vectors instead of
+     * copying them. It is used by loaders that parse directly into the final
+     * storage.
+     * @param triangleList - the oriented triangle list. Its size must be a
+     * multiple of 3.
+     * @param vertexList - vertex list, stored as in the other constructor.
+     * @param numberCoordinatesByVertex - number of coordinates by vertex.
+     */
+    CornerTableT( std::vector< CornerType >&& triangleList, std::vector< double >&& vertexList,
+        const unsigned int numberCoordinatesByVertex );
+
+    /**
+     * Constructor that takes all the tables of an already built Corner Table,
+     * as stored by MeshCache. The opposite table is not recomputed.
+     * @param triangleList - the oriented triangle list (table V).
+     * @param oppositeList - the opposite corners (table O), with the same size
+     * of the triangle list.
+     * @param vertexToCornerList - a corner to each vertex.
+     * @param vertexList - vertex list, stored as in the other constructors.
+     * @param numberCoordinatesByVertex - number of coordinates by vertex.
+     * @param nonManifoldList - corners in front of non-manifold edges.
+     */
+    CornerTableT( std::vector< CornerType >&& triangleList, std::vector< CornerType >&& oppositeList,
+        std::vector< CornerType >&& vertexToCornerList, std::vector< double >&& vertexList,
+        const unsigned int numberCoordinatesByVertex,
+        std::vector< CornerType >&& nonManifoldList = std::vector< CornerType >( ) );
+
     /**
      * Destructor of the Corner Table. Free all allocated memory.
      */
-    ~CornerTable( );
+    ~CornerTableT( );
 
     /**
      * Return the number of vertices on current surface.
@@ -53,10 +96,49 @@ public:
     CornerType getNumTriangles( ) const;
 
     /**
-     * Return the vertex list with the attributes of each vertex.
+     * Return the vertex list with the attributes of each vertex contiguous.
+     * It is only declared for InterleavedStorage, so that the vertex v is
+     * always at 3 * v; the blocks of PlanarStorage are read with
+     * getStorage( ).getCoordinate( ).
      * @return - vertex list with the attributes of each vertex.
      */
-    double* getAttributes( ) const;
+    template< class S = Storage >
+    inline typename std::enable_if< S::IS_INTERLEAVED, ScalarType* >::type getAttributes( ) const
+    {
+        return _attributes.getData( );
+    };
+
+    /**
+     * Return an attribute of a vertex, whatever the storage layout.
+     * @param vertex - vertex index.
+     * @param coordinate - attribute index, 0 to 2 for x, y and z.
+     * @return - value of the attribute.
+     */
+    inline ScalarType getCoordinate( const CornerType vertex, const unsigned int coordinate ) const
+    {
+        return _attributes.get( vertex, coordinate );
+    };
+
+    /**
+     * Change an attribute of a vertex, whatever the storage layout.
+     * @param vertex - vertex index.
+     * @param coordinate - attribute index, 0 to 2 for x, y and z.
+     * @param value - new value of the attribute.
+     */
+    inline void setCoordinate( const CornerType vertex, const unsigned int coordinate, const ScalarType value )
+    {
+        _attributes.set( vertex, coordinate, value );
+    };
+
+    /**
+     * Return the storage of the vertex attributes, to be read by the loops
+     * over all vertices.
+     * @return - vertex storage.
+     */
+    inline const Storage& getStorage( ) const
+    {
+        return _attributes;
+    };
 
     /**
      * Return the vertex of the corner. It is obtained by acessing the triangle
@@ -80,6 +162,18 @@ public:
      */
     const CornerType * getTriangleList( ) const;
 
+    /**
+     * Return the opposite table (table O).
+     * @return - opposite corner of each corner.
+     */
+    const CornerType * getOppositeList( ) const;
+
+    /**
+     * Return the table that stores a corner to each vertex.
+     * @return - a corner of each vertex.
+     */
+    const CornerType * getVertexToCornerList( ) const;
+
     /**
      * Return the triangle of the corner.
      * @param corner - corner index.
@@ -158,7 +252,7 @@ public:
     inline CornerType cornerSwing( const CornerType corner ) const
     {
         CornerType r = cornerRight( corner );
-        if ( r != CornerTable::BORDER_CORNER )
+        if ( r != BORDER_CORNER )
         {
             return cornerNext( r );
         }
@@ -176,7 +270,7 @@ public:
     inline CornerType cornerUnswing( const CornerType corner ) const
     {
         CornerType l = cornerLeft( corner );
-        if ( l != CornerTable::BORDER_CORNER )
+        if ( l != BORDER_CORNER )
         {
             return cornerPrevious( l );
         }
@@ -201,6 +295,15 @@ public:
      */
     void setReallocationFactor( const unsigned int realocationFactor );
 
+    /**
+     * Allocate memory for a number of triangles and vertices, so that the
+     * operations that add them up to those numbers do not reallocate the
+     * tables.
+     * @param numberTriangles - number of triangles.
+     * @param numberVertices - number of vertices.
+     */
+    void reserve( const CornerType numberTriangles, const CornerType numberVertices );
+
     /**
      * Perform the Edge Split operation on the opposite edge. This operation 
      * inserts a new vertex over the edge opposite to the 'corner' and replace
@@ -211,6 +314,16 @@ public:
      */
     void edgeSplit( const CornerType corner, const double* coordinates );
 
+    /**
+     * Perform the Triangle Split operation. This operation inserts a new
+     * vertex inside of the triangle and replace it by three triangles. The
+     * first one keeps the index of the triangle, with the new vertex on its
+     * third corner, and the other two are added on the final of the list.
+     * @param triangle - triangle index to apply the Triangle Split Operation.
+     * @param coordinates - new coordinates and attributes to the new vertex.
+     */
+    void triangleSplit( const CornerType triangle, const double* coordinates );
+
     /**
      * Perform the Edge Flip operation on the edge opposite to the 'corner'. In
      * case of a border edge this operation is not allowed.
@@ -252,6 +365,31 @@ public:
     double getVertexAverageEdgeLength( const CornerType vertex );
     
     bool areEdgeTrianglesInCircumsphere( const CornerType corner );
+
+    /**
+     * Compute the length of the edge opposite to each corner in one pass,
+     * with the vector kernels of GeometryKernels.
+     * @param edgeLengths - filled with the edgeLength of each corner.
+     */
+    void computeEdgeLengths( std::vector< double >& edgeLengths ) const;
+
+    /**
+     * Compute getVertexAverageEdgeLength for all vertices from the edge
+     * lengths of computeEdgeLengths, without allocating the neighbours of
+     * each vertex. The results are the same.
+     * @param edgeLengths - the length of the edge opposite to each corner.
+     * @param averages - filled with the average of each vertex.
+     */
+    void computeVertexAverageEdgeLengths( const std::vector< double >& edgeLengths,
+                                          std::vector< double >& averages ) const;
+
+    /**
+     * Compute the area and the unit normal of all triangles in one pass,
+     * with the vector kernels of GeometryKernels.
+     * @param areas - filled with the area of each triangle.
+     * @param normals - filled with the normal (x, y, z) of each triangle.
+     */
+    void computeFaceAreasAndNormals( std::vector< double >& areas, std::vector< double >& normals ) const;
     
     /**
      * Return the number of attributes by vertex.
@@ -259,6 +397,13 @@ public:
      */
     unsigned int getNumberAttributesByVertex( ) const;
 
+    /**
+     * Return the memory held by the table: the capacity of its arrays, of
+     * the attribute storage and of the border tracking.
+     * @return - number of bytes allocated.
+     */
+    size_t getAllocatedBytes( ) const;
+
     /**
      * Print the triangle list. Used just in debug.
      */
@@ -271,17 +416,261 @@ public:
      */
     const std::vector<CornerType> getCornerNeighbours( const CornerType corner ) const;
 
+    /**@class StarIterator
+     * Forward iterator over the neighbors corners of a vertex star, in the
+     * order of getCornerNeighbours. The star is walked lazily with cornerRight
+     * and, if a border is reached, cornerLeft from the other side.
+     */
+    class StarIterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef CornerType value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const CornerType* pointer;
+        typedef CornerType reference;
+
+        StarIterator( ) : _table( 0 ), _corner( BORDER_CORNER ), _current( BORDER_CORNER ), _isLeft( false ) { };
+
+        StarIterator( const CornerTableT* table, const CornerType corner, const CornerType current ) :
+            _table( table ), _corner( corner ), _current( current ), _isLeft( false ) { };
+
+        inline CornerType operator*( ) const
+        {
+            return _current;
+        };
+
+        inline StarIterator& operator++( )
+        {
+            if (_isLeft)
+            {
+                _current = _table->cornerLeft( _current );
+                _isLeft = _current != BORDER_CORNER;
+                return *this;
+            }
+
+            CornerType next = _table->cornerRight( _current );
+
+            if (next == BORDER_CORNER)
+            {
+                //Continue on the left direction.
+                _current = _table->cornerPrevious( _corner );
+                _isLeft = true;
+            }
+            else
+            {
+                _current = ( next == _table->cornerNext( _corner ) ) ? BORDER_CORNER : next;
+            }
+
+            return *this;
+        };
+
+        inline StarIterator operator++( int )
+        {
+            StarIterator previous = *this;
+            ++( *this );
+            return previous;
+        };
+
+        inline bool operator==( const StarIterator& other ) const
+        {
+            return _current == other._current && _isLeft == other._isLeft;
+        };
+
+        inline bool operator!=( const StarIterator& other ) const
+        {
+            return !( *this == other );
+        };
+
+    private:
+        const CornerTableT* _table;
+        CornerType _corner;
+        CornerType _current;
+        bool _isLeft;
+    };
+
+    /**@class StarRange
+     * Range of a vertex star, to be used on range-for loops.
+     */
+    class StarRange
+    {
+    public:
+        StarRange( const CornerTableT* table, const CornerType corner ) : _table( table ), _corner( corner ) { };
+
+        inline StarIterator begin( ) const
+        {
+            return StarIterator( _table, _corner, _table->cornerNext( _corner ) );
+        };
+
+        inline StarIterator end( ) const
+        {
+            return StarIterator( _table, _corner, BORDER_CORNER );
+        };
+
+    private:
+        const CornerTableT* _table;
+        CornerType _corner;
+    };
+
+    /**
+     * Return the neighbors corners on the vertex star of the 'corner' as a
+     * range, without allocating them.
+     * @param corner - corner index of a vertex.
+     * @return - range with the neighbors, in the order of getCornerNeighbours.
+     */
+    inline StarRange getCornerStar( const CornerType corner ) const
+    {
+        return StarRange( this, corner );
+    };
+
+    /**
+     * Call 'visitor' with each neighbor corner on the vertex star of the
+     * 'corner', in the order of getCornerNeighbours.
+     * @param corner - corner index of a vertex.
+     * @param visitor - function object called as visitor( neighbourCorner ).
+     */
+    template< class Visitor >
+    inline void forEachCornerNeighbour( const CornerType corner, Visitor visitor ) const
+    {
+        //Right direction, until the border or the first corner.
+        CornerType firstCorner = cornerNext( corner );
+        CornerType currentCorner = firstCorner;
+        do
+        {
+            visitor( currentCorner );
+            currentCorner = cornerRight( currentCorner );
+        }
+        while (currentCorner != BORDER_CORNER && currentCorner != firstCorner);
+
+        if (currentCorner != BORDER_CORNER)
+        {
+            return;
+        }
+
+        //Left direction, from the other side of the border.
+        currentCorner = cornerPrevious( corner );
+        do
+        {
+            visitor( currentCorner );
+            currentCorner = cornerLeft( currentCorner );
+        }
+        while (currentCorner != BORDER_CORNER);
+    };
+
     /**
      * Compute the Euler Characteristic. Used just in debug.
      * @return - Euler Characteristic.
      */
     CornerType computeEulerCharacteristic( );
 
+    /**
+     * Return the corners in front of non-manifold edges found when the
+     * opposite table was built: edges shared by more than two triangles or
+     * by two triangles with the same orientation. These corners are left
+     * without opposite, as border corners.
+     * @return - sorted list of corners.
+     */
+    const std::vector<CornerType>& getNonManifoldCorners( ) const;
+
+    /**
+     * Find the loops of border edges of the mesh, on all its connected
+     * components. Each border corner gives the edge from the vertex of its
+     * next corner to the vertex of its previous corner. A loop starts on its
+     * smallest vertex, follows these edges and is then reversed, and the
+     * loops are sorted by their smallest vertex.
+     * @return - list of vertices of each loop.
+     */
+    std::vector< std::vector<CornerType> > computeBorderLoops( ) const;
+
+    /**
+     * Start to keep the border loops up to date. From then on, the edge
+     * operations splice the border edges they change into next and previous
+     * vertex links, and record their vertices for getBorderLoops.
+     */
+    void trackBorderLoops( );
+
+    /**
+     * Return the border loops of the mesh, the same loops of
+     * computeBorderLoops. Each loop is given by one of its vertices and is
+     * followed by getNextBorderVertex. The cost is linear on the number of
+     * border vertices changed since the last call, unless the changes split
+     * or merged loops, in which case the loops through them are walked
+     * again. The tracking is started on the first call.
+     * @return - a vertex of each loop, keyed by loop identifier.
+     */
+    const std::map< CornerType, CornerType >& getBorderLoops( );
+
+    /**
+     * Return the end of the border edge that starts on a vertex, while the
+     * border loops are tracked.
+     * @param vertex - vertex index.
+     * @return - next vertex on the loop, or BORDER_CORNER.
+     */
+    CornerType getNextBorderVertex( const CornerType vertex ) const;
+
+    /**
+     * Return the start of the border edge that ends on a vertex, while the
+     * border loops are tracked.
+     * @param vertex - vertex index.
+     * @return - previous vertex on the loop, or BORDER_CORNER.
+     */
+    CornerType getPreviousBorderVertex( const CornerType vertex ) const;
+
+    /**
+     * Return the border corner whose edge starts on a vertex, while the
+     * border loops are tracked.
+     * @param vertex - vertex index.
+     * @return - border corner, or BORDER_CORNER if the vertex does not start
+     * a border edge.
+     */
+    CornerType getBorderCorner( const CornerType vertex ) const;
+
+    /**
+     * Append a patch that fills a hole of the mesh. The first vertices of
+     * the patch are the vertices of the hole, in the order of the boundary,
+     * and take their place; the other ones are appended. Each border edge of
+     * the patch along the boundary is made opposite to the border edge of
+     * the hole in the reverse direction, so the cost is linear on the size of
+     * the patch and of the stars of the hole vertices. The patch must have
+     * the orientation of the boundary given by computeBorderLoops. Every
+     * edge of the seam is checked first, and the mesh is not changed if one
+     * of them does not match.
+     * @param patch - patch mesh, with the attributes of this one.
+     * @param boundary - vertices of the hole.
+     * @return - true if the patch was stitched, false if it does not match
+     * the hole.
+     */
+    bool stitchPatch( const CornerTableT& patch, const std::vector<CornerType>& boundary );
+
+    /**
+     * Remove the last triangles and vertices, as appended by stitchPatch, so
+     * the holes they filled are open again. The cost is linear on the number
+     * of removed corners, plus a rebuild of the border loops if they are
+     * tracked. The kept vertices must not refer to removed corners.
+     * @param numberTriangles - number of triangles to keep.
+     * @param numberVertices - number of vertices to keep.
+     */
+    void truncate( const CornerType numberTriangles, const CornerType numberVertices );
+
+    /**
+     * Set the minimum number of corners for which the opposite table is built
+     * and the border corners are searched by several threads. The number of
+     * threads is the OpenMP default.
+     * @param numberCorners - minimum number of corners. Zero always uses the
+     * parallel builder.
+     */
+    static void setParallelBuildThreshold( const CornerType numberCorners );
+
     /**
      * Especial id for birder edge.
      */
     static const CornerType BORDER_CORNER = -1;
 private:
+    /**
+     * Corners in front of non-manifold edges, sorted.
+     */
+    std::vector< CornerType > _nonManifoldCorners;
+
     /**
      * The opposite corners vector, or table O.
      */
@@ -301,7 +690,7 @@ private:
     /**
      * The attributes vertex vector, or table G (geometry table).
      */
-    std::vector<double> _attributes;
+    Storage _attributes;
 
     /**
      * Number of coordinates by vertex.
@@ -332,6 +721,49 @@ private:
      * The reallocation factor.
      */
     unsigned int _reallocationFactor;
+
+    /**
+     * True if the border loops are kept up to date by the edge operations.
+     */
+    bool _isTrackingBorder;
+
+    /**
+     * Border corner whose edge starts on each vertex, or BORDER_CORNER.
+     */
+    std::vector< CornerType > _borderCornerOfVertex;
+
+    /**
+     * Start of the border edge that ends on each vertex, or BORDER_CORNER.
+     */
+    std::vector< CornerType > _previousBorderVertex;
+
+    /**
+     * Identifier of the border loop of each vertex, or BORDER_CORNER.
+     */
+    std::vector< CornerType > _loopOfVertex;
+
+    /**
+     * Vertices of the border edges changed since the last getBorderLoops,
+     * and the next border vertex each one had then.
+     */
+    std::vector< CornerType > _dirtyBorderVertices;
+    std::vector< CornerType > _lastNextBorderVertex;
+    std::vector< bool > _isDirtyBorderVertex;
+
+    /**
+     * A vertex of each border loop, keyed by loop identifier.
+     */
+    std::map< CornerType, CornerType > _borderLoops;
+
+    /**
+     * Identifier of the next border loop found.
+     */
+    CornerType _nextBorderLoopId;
+
+    /**
+     * Triangles changed by the current edge operation.
+     */
+    std::vector< CornerType > _updatedBorderTriangles;
 private:
     /**
      * Reallocate memory for vectors when it is necessary.
@@ -339,9 +771,147 @@ private:
     void resizeVectors( );
 
     /**
-     * Build the opposite table on constructor.
+     * Reallocate memory for vectors so they hold at least the given numbers
+     * of triangles and vertices.
+     */
+    void reserveVectors( const CornerType numberTriangles, const CornerType numberVertices );
+
+    /**
+     * Return the border corner whose edge starts on a vertex, searching the
+     * triangles of its star if the border is not tracked.
+     */
+    CornerType findBorderCorner( const CornerType vertex ) const;
+
+    /**
+     * Grow the tracked border information to the number of vertices.
+     */
+    void resizeBorderTracking( );
+
+    /**
+     * Compute all the tracked border information from the opposite table.
+     */
+    void rebuildBorderLoops( );
+
+    /**
+     * Update the loops through the changed vertices in time linear on their
+     * number, if every vertex that joined or left the border did so between
+     * two vertices that stayed on it, in the same order.
+     * @return - false, with nothing changed, if a loop was split or merged.
+     */
+    bool spliceBorderLoops( );
+
+    /**
+     * Walk again the loops through the changed vertices.
+     * @return - false if a walk found an open chain or a vertex shared by
+     * two loops.
+     */
+    bool walkBorderLoops( );
+
+    /**
+     * Record a vertex whose border edges change, and its next border vertex
+     * before the change.
+     */
+    void markDirtyBorderVertex( const CornerType vertex );
+
+    void clearDirtyBorderVertices( );
+
+    /**
+     * Remove the border edges of the triangles an edge operation is going to
+     * change, if the border loops are tracked.
+     * @param triangles - triangle indices, BORDER_CORNER being ignored.
+     */
+    void beginBorderUpdate( std::initializer_list<CornerType> triangles );
+
+    /**
+     * Add the border edges of the triangles changed by an edge operation, if
+     * the border loops are tracked.
+     * @param newTriangles - triangles created by the operation, besides the
+     * ones given to beginBorderUpdate.
+     */
+    void endBorderUpdate( std::initializer_list<CornerType> newTriangles );
+
+    /**
+     * Remove or add the border edge in front of a corner on the tracked
+     * border, if the corner is on the border.
+     */
+    void removeBorderCorner( const CornerType corner );
+    void addBorderCorner( const CornerType corner );
+
+    /**
+     * Build the opposite table on constructor. Large meshes are built by
+     * buildOppositeTableParallel when more than one thread is available, the
+     * others by buildOppositeTableSerial. Both give the same tables.
      */
     void buildOppositeTable( );
+
+    /**
+     * Match each corner to its opposite through a hash table keyed on the
+     * directed edge in front of the corner, so the construction is linear on
+     * the number of corners.
+     */
+    void buildOppositeTableSerial( );
+
+    /**
+     * Match the corners with OpenMP threads. The undirected edge in front of
+     * each corner is written as a (min vertex, max vertex) key, the keys are
+     * sorted by a parallel radix sort and each run of equal keys is paired.
+     */
+    void buildOppositeTableParallel( );
+
+    /**
+     * Fill the table that stores a corner to each vertex, once the opposite
+     * table is complete. A vertex on the border gets the corner that starts
+     * the traverse of its star on the border.
+     */
+    void buildVertexToCornerTable( );
+
+    /**
+     * Entry of the edge hash table used by buildOppositeTableSerial.
+     */
+    struct EdgeSlot
+    {
+        static const uint64_t EMPTY_KEY = ~( uint64_t ) 0;
+
+        EdgeSlot( ) : key( EMPTY_KEY ), corner( BORDER_CORNER ), isRepeated( false ) { };
+
+        uint64_t key;
+        CornerType corner;
+        bool isRepeated;
+    };
+
+    /**
+     * Return the key of the directed edge from vertex 'from' to vertex 'to'.
+     */
+    static inline uint64_t edgeKey( const CornerType from, const CornerType to )
+    {
+        return ( ( uint64_t ) ( uint32_t ) from << 32 ) | ( uint32_t ) to;
+    };
+
+    /**
+     * Return the home slot of an edge key on a table with 2^bits slots
+     * (Fibonacci hashing).
+     */
+    static inline size_t edgeHashSlot( const uint64_t key, const unsigned int bits )
+    {
+        return ( size_t ) ( ( key * 0x9E3779B97F4A7C15ull ) >> ( 64 - bits ) );
+    };
 };
 
+/**
+ * The Corner Table used by the application: double precision attributes
+ * stored by vertex.
+ */
+typedef CornerTableT< InterleavedStorage< double > > CornerTable;
+
+/**
+ * Corner Table with single precision attributes stored by coordinate.
+ */
+typedef CornerTableT< PlanarStorage< float > > PlanarCornerTable;
+
+//The members are instantiated on CornerTable.cpp.
+extern template class CornerTableT< InterleavedStorage< double > >;
+extern template class CornerTableT< InterleavedStorage< float > >;
+extern template class CornerTableT< PlanarStorage< double > >;
+extern template class CornerTableT< PlanarStorage< float > >;
+
 #endif
@@ -0,0 +1,399 @@
+/*
+ * File:   GeometryKernels.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "GeometryKernels.h"
+
+#include <cmath>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define GEOMETRY_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+// The vector code computes every value with the same operations, in the same
+// order, of the scalar code below, so both give identical results.
+
+template< typename Scalar >
+static void edgeLengthsScalar( const CornerType* triangleList, CornerType begin, CornerType end,
+                               const Scalar* x, const Scalar* y, const Scalar* z, size_t stride,
+                               double* edgeLengths )
+{
+    for( CornerType triangle = begin; triangle < end; triangle++ )
+    {
+        const CornerType* vertices = triangleList + 3 * triangle;
+
+        for( int k = 0; k < 3; k++ )
+        {
+            // Edge from the previous to the next vertex of the corner
+            size_t a = stride * vertices[ ( k + 2 ) % 3 ];
+            size_t b = stride * vertices[ ( k + 1 ) % 3 ];
+
+            double dx = ( double )x[ a ] - ( double )x[ b ];
+            double dy = ( double )y[ a ] - ( double )y[ b ];
+            double dz = ( double )z[ a ] - ( double )z[ b ];
+
+            edgeLengths[ 3 * triangle + k ] = sqrt( dx * dx + dy * dy + dz * dz );
+        }
+    }
+}
+
+template< typename Scalar >
+static void faceAreasAndNormalsScalar( const CornerType* triangleList, CornerType begin, CornerType end,
+                                       const Scalar* x, const Scalar* y, const Scalar* z, size_t stride,
+                                       double* areas, double* normals )
+{
+    for( CornerType triangle = begin; triangle < end; triangle++ )
+    {
+        size_t v0 = stride * triangleList[ 3 * triangle ];
+        size_t v1 = stride * triangleList[ 3 * triangle + 1 ];
+        size_t v2 = stride * triangleList[ 3 * triangle + 2 ];
+
+        double ux = ( double )x[ v1 ] - ( double )x[ v0 ];
+        double uy = ( double )y[ v1 ] - ( double )y[ v0 ];
+        double uz = ( double )z[ v1 ] - ( double )z[ v0 ];
+        double wx = ( double )x[ v2 ] - ( double )x[ v0 ];
+        double wy = ( double )y[ v2 ] - ( double )y[ v0 ];
+        double wz = ( double )z[ v2 ] - ( double )z[ v0 ];
+
+        double nx = uy * wz - uz * wy;
+        double ny = uz * wx - ux * wz;
+        double nz = ux * wy - uy * wx;
+        double length = sqrt( nx * nx + ny * ny + nz * nz );
+
+        areas[ triangle ] = 0.5 * length;
+
+        if( length > 0 )
+        {
+            normals[ 3 * triangle ] = nx / length;
+            normals[ 3 * triangle + 1 ] = ny / length;
+            normals[ 3 * triangle + 2 ] = nz / length;
+        }
+        else
+        {
+            normals[ 3 * triangle ] = normals[ 3 * triangle + 1 ] = normals[ 3 * triangle + 2 ] = 0;
+        }
+    }
+}
+
+#ifdef GEOMETRY_KERNELS_X86
+
+// Offsets of the coordinates of vertex k of 4 consecutive triangles
+__attribute__( ( target( "avx2" ) ) )
+static inline __m256i vertexOffsetsAVX2( const CornerType* vertices, int k, size_t stride )
+{
+    __m128i indices = _mm_set_epi32( vertices[ 9 + k ], vertices[ 6 + k ], vertices[ 3 + k ], vertices[ k ] );
+
+    return _mm256_mul_epu32( _mm256_cvtepu32_epi64( indices ), _mm256_set1_epi64x( stride ) );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static CornerType edgeLengthsAVX2( const CornerType* triangleList, CornerType numberTriangles,
+                                   const double* x, const double* y, const double* z, size_t stride,
+                                   double* edgeLengths )
+{
+    CornerType triangle = 0;
+
+    for( ; triangle + 4 <= numberTriangles; triangle += 4 )
+    {
+        const CornerType* vertices = triangleList + 3 * triangle;
+        __m256d px[ 3 ], py[ 3 ], pz[ 3 ];
+
+        for( int k = 0; k < 3; k++ )
+        {
+            __m256i offsets = vertexOffsetsAVX2( vertices, k, stride );
+            px[ k ] = _mm256_i64gather_pd( x, offsets, 8 );
+            py[ k ] = _mm256_i64gather_pd( y, offsets, 8 );
+            pz[ k ] = _mm256_i64gather_pd( z, offsets, 8 );
+        }
+
+        double lengths[ 3 ][ 4 ];
+
+        for( int k = 0; k < 3; k++ )
+        {
+            int a = ( k + 2 ) % 3;
+            int b = ( k + 1 ) % 3;
+
+            __m256d dx = _mm256_sub_pd( px[ a ], px[ b ] );
+            __m256d dy = _mm256_sub_pd( py[ a ], py[ b ] );
+            __m256d dz = _mm256_sub_pd( pz[ a ], pz[ b ] );
+            __m256d sum = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( dx, dx ), _mm256_mul_pd( dy, dy ) ),
+                                         _mm256_mul_pd( dz, dz ) );
+
+            _mm256_storeu_pd( lengths[ k ], _mm256_sqrt_pd( sum ) );
+        }
+
+        for( int i = 0; i < 4; i++ )
+        {
+            edgeLengths[ 3 * ( triangle + i ) ] = lengths[ 0 ][ i ];
+            edgeLengths[ 3 * ( triangle + i ) + 1 ] = lengths[ 1 ][ i ];
+            edgeLengths[ 3 * ( triangle + i ) + 2 ] = lengths[ 2 ][ i ];
+        }
+    }
+
+    return triangle;
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static CornerType faceAreasAndNormalsAVX2( const CornerType* triangleList, CornerType numberTriangles,
+                                           const double* x, const double* y, const double* z, size_t stride,
+                                           double* areas, double* normals )
+{
+    CornerType triangle = 0;
+
+    for( ; triangle + 4 <= numberTriangles; triangle += 4 )
+    {
+        const CornerType* vertices = triangleList + 3 * triangle;
+        __m256d px[ 3 ], py[ 3 ], pz[ 3 ];
+
+        for( int k = 0; k < 3; k++ )
+        {
+            __m256i offsets = vertexOffsetsAVX2( vertices, k, stride );
+            px[ k ] = _mm256_i64gather_pd( x, offsets, 8 );
+            py[ k ] = _mm256_i64gather_pd( y, offsets, 8 );
+            pz[ k ] = _mm256_i64gather_pd( z, offsets, 8 );
+        }
+
+        __m256d ux = _mm256_sub_pd( px[ 1 ], px[ 0 ] );
+        __m256d uy = _mm256_sub_pd( py[ 1 ], py[ 0 ] );
+        __m256d uz = _mm256_sub_pd( pz[ 1 ], pz[ 0 ] );
+        __m256d wx = _mm256_sub_pd( px[ 2 ], px[ 0 ] );
+        __m256d wy = _mm256_sub_pd( py[ 2 ], py[ 0 ] );
+        __m256d wz = _mm256_sub_pd( pz[ 2 ], pz[ 0 ] );
+
+        __m256d nx = _mm256_sub_pd( _mm256_mul_pd( uy, wz ), _mm256_mul_pd( uz, wy ) );
+        __m256d ny = _mm256_sub_pd( _mm256_mul_pd( uz, wx ), _mm256_mul_pd( ux, wz ) );
+        __m256d nz = _mm256_sub_pd( _mm256_mul_pd( ux, wy ), _mm256_mul_pd( uy, wx ) );
+        __m256d length = _mm256_sqrt_pd( _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( nx, nx ),
+                                                                       _mm256_mul_pd( ny, ny ) ),
+                                                        _mm256_mul_pd( nz, nz ) ) );
+
+        // Degenerated triangles get a null normal instead of NaN
+        __m256d isValid = _mm256_cmp_pd( length, _mm256_setzero_pd(), _CMP_GT_OQ );
+
+        double n[ 3 ][ 4 ];
+        _mm256_storeu_pd( areas + triangle, _mm256_mul_pd( _mm256_set1_pd( 0.5 ), length ) );
+        _mm256_storeu_pd( n[ 0 ], _mm256_and_pd( _mm256_div_pd( nx, length ), isValid ) );
+        _mm256_storeu_pd( n[ 1 ], _mm256_and_pd( _mm256_div_pd( ny, length ), isValid ) );
+        _mm256_storeu_pd( n[ 2 ], _mm256_and_pd( _mm256_div_pd( nz, length ), isValid ) );
+
+        for( int i = 0; i < 4; i++ )
+        {
+            normals[ 3 * ( triangle + i ) ] = n[ 0 ][ i ];
+            normals[ 3 * ( triangle + i ) + 1 ] = n[ 1 ][ i ];
+            normals[ 3 * ( triangle + i ) + 2 ] = n[ 2 ][ i ];
+        }
+    }
+
+    return triangle;
+}
+
+#ifdef __SSE2__
+
+static inline void loadVertexSSE2( const CornerType* vertices, int k, size_t stride,
+                                   const double* x, const double* y, const double* z,
+                                   __m128d& px, __m128d& py, __m128d& pz )
+{
+    size_t a = stride * vertices[ k ];
+    size_t b = stride * vertices[ 3 + k ];
+
+    px = _mm_set_pd( x[ b ], x[ a ] );
+    py = _mm_set_pd( y[ b ], y[ a ] );
+    pz = _mm_set_pd( z[ b ], z[ a ] );
+}
+
+static CornerType edgeLengthsSSE2( const CornerType* triangleList, CornerType numberTriangles,
+                                   const double* x, const double* y, const double* z, size_t stride,
+                                   double* edgeLengths )
+{
+    CornerType triangle = 0;
+
+    for( ; triangle + 2 <= numberTriangles; triangle += 2 )
+    {
+        const CornerType* vertices = triangleList + 3 * triangle;
+        __m128d px[ 3 ], py[ 3 ], pz[ 3 ];
+
+        for( int k = 0; k < 3; k++ )
+            loadVertexSSE2( vertices, k, stride, x, y, z, px[ k ], py[ k ], pz[ k ] );
+
+        for( int k = 0; k < 3; k++ )
+        {
+            int a = ( k + 2 ) % 3;
+            int b = ( k + 1 ) % 3;
+
+            __m128d dx = _mm_sub_pd( px[ a ], px[ b ] );
+            __m128d dy = _mm_sub_pd( py[ a ], py[ b ] );
+            __m128d dz = _mm_sub_pd( pz[ a ], pz[ b ] );
+            __m128d length = _mm_sqrt_pd( _mm_add_pd( _mm_add_pd( _mm_mul_pd( dx, dx ), _mm_mul_pd( dy, dy ) ),
+                                                      _mm_mul_pd( dz, dz ) ) );
+
+            _mm_storel_pd( edgeLengths + 3 * triangle + k, length );
+            _mm_storeh_pd( edgeLengths + 3 * ( triangle + 1 ) + k, length );
+        }
+    }
+
+    return triangle;
+}
+
+static CornerType faceAreasAndNormalsSSE2( const CornerType* triangleList, CornerType numberTriangles,
+                                           const double* x, const double* y, const double* z, size_t stride,
+                                           double* areas, double* normals )
+{
+    CornerType triangle = 0;
+
+    for( ; triangle + 2 <= numberTriangles; triangle += 2 )
+    {
+        const CornerType* vertices = triangleList + 3 * triangle;
+        __m128d px[ 3 ], py[ 3 ], pz[ 3 ];
+
+        for( int k = 0; k < 3; k++ )
+            loadVertexSSE2( vertices, k, stride, x, y, z, px[ k ], py[ k ], pz[ k ] );
+
+        __m128d ux = _mm_sub_pd( px[ 1 ], px[ 0 ] );
+        __m128d uy = _mm_sub_pd( py[ 1 ], py[ 0 ] );
+        __m128d uz = _mm_sub_pd( pz[ 1 ], pz[ 0 ] );
+        __m128d wx = _mm_sub_pd( px[ 2 ], px[ 0 ] );
+        __m128d wy = _mm_sub_pd( py[ 2 ], py[ 0 ] );
+        __m128d wz = _mm_sub_pd( pz[ 2 ], pz[ 0 ] );
+
+        __m128d n[ 3 ];
+        n[ 0 ] = _mm_sub_pd( _mm_mul_pd( uy, wz ), _mm_mul_pd( uz, wy ) );
+        n[ 1 ] = _mm_sub_pd( _mm_mul_pd( uz, wx ), _mm_mul_pd( ux, wz ) );
+        n[ 2 ] = _mm_sub_pd( _mm_mul_pd( ux, wy ), _mm_mul_pd( uy, wx ) );
+        __m128d length = _mm_sqrt_pd( _mm_add_pd( _mm_add_pd( _mm_mul_pd( n[ 0 ], n[ 0 ] ),
+                                                              _mm_mul_pd( n[ 1 ], n[ 1 ] ) ),
+                                                  _mm_mul_pd( n[ 2 ], n[ 2 ] ) ) );
+
+        // Degenerated triangles get a null normal instead of NaN
+        __m128d isValid = _mm_cmpgt_pd( length, _mm_setzero_pd() );
+
+        _mm_storeu_pd( areas + triangle, _mm_mul_pd( _mm_set1_pd( 0.5 ), length ) );
+
+        for( int k = 0; k < 3; k++ )
+        {
+            __m128d unit = _mm_and_pd( _mm_div_pd( n[ k ], length ), isValid );
+
+            _mm_storel_pd( normals + 3 * triangle + k, unit );
+            _mm_storeh_pd( normals + 3 * ( triangle + 1 ) + k, unit );
+        }
+    }
+
+    return triangle;
+}
+
+#endif /* __SSE2__ */
+
+#endif /* GEOMETRY_KERNELS_X86 */
+
+GeometryKernels::InstructionSet GeometryKernels::_instructionSet = GeometryKernels::getSupportedInstructionSet();
+
+GeometryKernels::InstructionSet GeometryKernels::getSupportedInstructionSet()
+{
+#ifdef GEOMETRY_KERNELS_X86
+    if( __builtin_cpu_supports( "avx2" ) )
+        return AVX2;
+
+#ifdef __SSE2__
+    return SSE2;
+#endif
+#endif
+
+    return SCALAR;
+}
+
+GeometryKernels::InstructionSet GeometryKernels::getInstructionSet()
+{
+    return _instructionSet;
+}
+
+void GeometryKernels::setInstructionSet( InstructionSet instructionSet )
+{
+    InstructionSet supported = getSupportedInstructionSet();
+
+    _instructionSet = ( instructionSet < supported ) ? instructionSet : supported;
+}
+
+// Vector paths exist only for double precision coordinates. Each returns the
+// number of triangles it processed, the remaining ones are left to the
+// scalar code.
+
+static CornerType edgeLengthsVector( GeometryKernels::InstructionSet, const CornerType*, CornerType,
+                                     const float*, const float*, const float*, size_t, double* )
+{
+    return 0;
+}
+
+static CornerType edgeLengthsVector( GeometryKernels::InstructionSet instructionSet,
+                                     const CornerType* triangleList, CornerType numberTriangles,
+                                     const double* x, const double* y, const double* z, size_t stride,
+                                     double* edgeLengths )
+{
+#ifdef GEOMETRY_KERNELS_X86
+    if( instructionSet == GeometryKernels::AVX2 )
+        return edgeLengthsAVX2( triangleList, numberTriangles, x, y, z, stride, edgeLengths );
+
+#ifdef __SSE2__
+    if( instructionSet == GeometryKernels::SSE2 )
+        return edgeLengthsSSE2( triangleList, numberTriangles, x, y, z, stride, edgeLengths );
+#endif
+#endif
+
+    return 0;
+}
+
+static CornerType faceAreasAndNormalsVector( GeometryKernels::InstructionSet, const CornerType*, CornerType,
+                                             const float*, const float*, const float*, size_t, double*, double* )
+{
+    return 0;
+}
+
+static CornerType faceAreasAndNormalsVector( GeometryKernels::InstructionSet instructionSet,
+                                             const CornerType* triangleList, CornerType numberTriangles,
+                                             const double* x, const double* y, const double* z, size_t stride,
+                                             double* areas, double* normals )
+{
+#ifdef GEOMETRY_KERNELS_X86
+    if( instructionSet == GeometryKernels::AVX2 )
+        return faceAreasAndNormalsAVX2( triangleList, numberTriangles, x, y, z, stride, areas, normals );
+
+#ifdef __SSE2__
+    if( instructionSet == GeometryKernels::SSE2 )
+        return faceAreasAndNormalsSSE2( triangleList, numberTriangles, x, y, z, stride, areas, normals );
+#endif
+#endif
+
+    return 0;
+}
+
+template< typename Scalar >
+void GeometryKernels::computeEdgeLengths( const CornerType* triangleList, CornerType numberTriangles,
+                                          const Scalar* x, const Scalar* y, const Scalar* z, size_t stride,
+                                          double* edgeLengths )
+{
+    CornerType done = edgeLengthsVector( _instructionSet, triangleList, numberTriangles, x, y, z, stride,
+                                         edgeLengths );
+
+    edgeLengthsScalar( triangleList, done, numberTriangles, x, y, z, stride, edgeLengths );
+}
+
+template< typename Scalar >
+void GeometryKernels::computeFaceAreasAndNormals( const CornerType* triangleList, CornerType numberTriangles,
+                                                  const Scalar* x, const Scalar* y, const Scalar* z, size_t stride,
+                                                  double* areas, double* normals )
+{
+    CornerType done = faceAreasAndNormalsVector( _instructionSet, triangleList, numberTriangles, x, y, z, stride,
+                                                 areas, normals );
+
+    faceAreasAndNormalsScalar( triangleList, done, numberTriangles, x, y, z, stride, areas, normals );
+}
+
+template void GeometryKernels::computeEdgeLengths< float >( const CornerType*, CornerType,
+    const float*, const float*, const float*, size_t, double* );
+template void GeometryKernels::computeEdgeLengths< double >( const CornerType*, CornerType,
+    const double*, const double*, const double*, size_t, double* );
+template void GeometryKernels::computeFaceAreasAndNormals< float >( const CornerType*, CornerType,
+    const float*, const float*, const float*, size_t, double*, double* );
+template void GeometryKernels::computeFaceAreasAndNormals< double >( const CornerType*, CornerType,
+    const double*, const double*, const double*, size_t, double*, double* );
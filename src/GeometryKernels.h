@@ -0,0 +1,90 @@
+/*
+ * File:   GeometryKernels.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef GEOMETRYKERNELS_H
+#define GEOMETRYKERNELS_H
+
+#include "CornerTable.h"
+#include <cstddef>
+
+/**@class GeometryKernels
+ * Batched geometric computations over all the triangles of a mesh. The
+ * vertex coordinates are read as three arrays with a common stride, so the
+ * same kernels work on interleaved (stride = number of attributes) and planar
+ * (stride = 1) storage. Double precision coordinates are processed 4 or 2
+ * triangles at a time with AVX2 or SSE2, chosen at run time; the results are
+ * the same of the scalar code, value by value.
+ */
+class GeometryKernels
+{
+public:
+
+    enum InstructionSet
+    {
+        SCALAR = 0,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * Return the widest instruction set supported by this processor.
+     * @return - instruction set.
+     */
+    static InstructionSet getSupportedInstructionSet();
+
+    /**
+     * Return the instruction set used by the kernels.
+     * @return - instruction set.
+     */
+    static InstructionSet getInstructionSet();
+
+    /**
+     * Limit the instruction set used by the kernels, mostly to compare them.
+     * It is never set above the supported one.
+     * @param instructionSet - widest instruction set to be used.
+     */
+    static void setInstructionSet( InstructionSet instructionSet );
+
+    /**
+     * Compute the length of the edge opposite to each corner, as
+     * CornerTable::edgeLength.
+     * @param triangleList - the triangle list (table V).
+     * @param numberTriangles - number of triangles.
+     * @param x - first x coordinate.
+     * @param y - first y coordinate.
+     * @param z - first z coordinate.
+     * @param stride - distance between the coordinates of two vertices.
+     * @param edgeLengths - filled with 3 * numberTriangles lengths.
+     */
+    template< typename Scalar >
+    static void computeEdgeLengths( const CornerType* triangleList, CornerType numberTriangles,
+                                    const Scalar* x, const Scalar* y, const Scalar* z, size_t stride,
+                                    double* edgeLengths );
+
+    /**
+     * Compute the area and the unit normal of each triangle. The normal
+     * follows the triangle orientation and is null for degenerated triangles.
+     * @param triangleList - the triangle list (table V).
+     * @param numberTriangles - number of triangles.
+     * @param x - first x coordinate.
+     * @param y - first y coordinate.
+     * @param z - first z coordinate.
+     * @param stride - distance between the coordinates of two vertices.
+     * @param areas - filled with numberTriangles areas.
+     * @param normals - filled with 3 * numberTriangles coordinates.
+     */
+    template< typename Scalar >
+    static void computeFaceAreasAndNormals( const CornerType* triangleList, CornerType numberTriangles,
+                                            const Scalar* x, const Scalar* y, const Scalar* z, size_t stride,
+                                            double* areas, double* normals );
+
+private:
+
+    static InstructionSet _instructionSet;
+};
+
+#endif /* GEOMETRYKERNELS_H */
+
@@ -0,0 +1,466 @@
+/*
+ * File:   HoleFiller.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "HoleFiller.h"
+#include "Trace.h"
+
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+static inline int omp_get_max_threads( )
+{
+    return 1;
+}
+
+static inline void omp_set_num_threads( int )
+{
+}
+#endif
+
+HoleFiller::HoleFiller( std::shared_ptr< CornerTable > cornerTable ) :
+    _cornerTable( cornerTable ),
+    _numberMeshTriangles( cornerTable->getNumTriangles() ),
+    _numberMeshVertices( cornerTable->getNumberVertices() ),
+    _isFilled( false ),
+    _fairingMode( SCALAR ),
+    _numberThreads( 0 )
+{
+    // Scale attributes of the refinement, computed once for all vertices
+    std::vector< double > edgeLengths;
+    _cornerTable->computeEdgeLengths( edgeLengths );
+    _cornerTable->computeVertexAverageEdgeLengths( edgeLengths, _vertexAverageEdgeLengths );
+
+    calculateHoleBoundaries();
+}
+
+void HoleFiller::setFairingMode( FairingMode mode )
+{
+    _fairingMode = mode;
+}
+
+HoleFiller::FairingMode HoleFiller::getFairingMode() const
+{
+    return _fairingMode;
+}
+
+void HoleFiller::setNumberThreads( int numberThreads )
+{
+    _numberThreads = numberThreads;
+}
+
+void HoleFiller::fill()
+{
+    TRACE_SCOPE( "fill" );
+
+    size_t numberHoles = _boundaries.size();
+    int defaultNumberThreads = omp_get_max_threads();
+    int numberThreads = ( _numberThreads > 0 ) ? _numberThreads : defaultNumberThreads;
+
+    // The parallel regions inside a hole use the same number of threads
+    omp_set_num_threads( numberThreads );
+
+    // The holes are opened again, so the triangulation sees the mesh around
+    // them as it was
+    if( _isFilled )
+    {
+        _cornerTable->truncate( _numberMeshTriangles, _numberMeshVertices );
+        _isFilled = false;
+    }
+
+    std::vector< std::shared_ptr< CornerTable > > refinedCornerTables( numberHoles );
+    std::vector< std::shared_ptr< CornerTable > > fairedCornerTables( numberHoles );
+    _patchCornerTables.assign( numberHoles, nullptr );
+    _holeStatistics.assign( numberHoles, HoleStatistics() );
+    _stageTimes.clear();
+
+    // Largest holes first, so that a big hole does not start when the others
+    // are done. The results are stored by hole, in the order of _boundaries.
+    std::vector< size_t > holeOrder( numberHoles );
+    std::iota( holeOrder.begin(), holeOrder.end(), 0 );
+    std::stable_sort( holeOrder.begin(), holeOrder.end(), [ & ]( size_t a, size_t b )
+    {
+        return _boundaries[ a ].size() > _boundaries[ b ].size();
+    } );
+
+    // The triangulation and the refinement do not depend on the fairing
+    // mode, so they are reused while the mesh is the same
+    size_t numberCachedHoles = 0;
+
+    for( size_t iHole = 0; iHole < numberHoles; iHole++ )
+    {
+        auto cached = _stageCache.find( getStageKey( _boundaries[ iHole ] ) );
+
+        if( cached == _stageCache.end() )
+            continue;
+
+        _patchCornerTables[ iHole ] = cached->second.triangulation;
+        refinedCornerTables[ iHole ] = cached->second.refinement;
+        _holeStatistics[ iHole ] = cached->second.statistics;
+        numberCachedHoles++;
+    }
+
+    if( numberCachedHoles > 0 )
+        std::cout << "Reused the triangulation and refinement of " << numberCachedHoles << " holes" << std::endl;
+
+    auto triangulateHole = [ & ]( size_t iHole )
+    {
+        if( _patchCornerTables[ iHole ] )
+            return;
+
+        const HoleBoundary& boundary = _boundaries[ iHole ];
+        HoleStatistics& statistics = _holeStatistics[ iHole ];
+        TRACE_SCOPE_ARGUMENT( "triangulate hole", "vertices", boundary.size() );
+        auto start = std::chrono::steady_clock::now();
+
+        _patchCornerTables[ iHole ] = calculatePatchMesh( boundary, calculateMinimumPatchMesh( boundary, &statistics.triangulation ) );
+
+        auto stop = std::chrono::steady_clock::now();
+        statistics.triangulationMilliseconds = std::chrono::duration< double, std::milli >( stop - start ).count();
+
+        const double* coordinates = _cornerTable->getAttributes();
+        statistics.boundaryVertices = boundary.size();
+        statistics.patchTriangles = _patchCornerTables[ iHole ]->getNumTriangles();
+
+        if( statistics.patchTriangles == 0 && boundary.size() >= 3 )
+        {
+            #pragma omp critical
+            std::cout << "Could not triangulate the hole with " << boundary.size() << " vertices" << std::endl;
+        }
+
+        for( size_t p = 0; p < boundary.size(); p++ )
+        {
+            const double* a = coordinates + 3 * boundary[ p ];
+            const double* b = coordinates + 3 * boundary[ ( p + 1 ) % boundary.size() ];
+
+            statistics.boundaryLength += std::sqrt( ( b[ 0 ] - a[ 0 ] ) * ( b[ 0 ] - a[ 0 ] ) +
+                                                    ( b[ 1 ] - a[ 1 ] ) * ( b[ 1 ] - a[ 1 ] ) +
+                                                    ( b[ 2 ] - a[ 2 ] ) * ( b[ 2 ] - a[ 2 ] ) );
+        }
+    };
+
+    auto recordTime = [ & ]( const std::string& name, std::chrono::steady_clock::time_point start )
+    {
+        auto stop = std::chrono::steady_clock::now();
+        double milliseconds = std::chrono::duration< double, std::milli >( stop - start ).count();
+
+        _stageTimes.push_back( { name, milliseconds } );
+
+        std::cout << name << ": " << milliseconds << " ms" << std::endl;
+    };
+
+    // Each stage runs on all the holes before the next one. The holes are
+    // taken one at a time by the free threads.
+    auto runStage = [ & ]( const char* name, const std::function< void ( size_t ) >& stage, size_t firstHole )
+    {
+        TRACE_SCOPE( name );
+        auto start = std::chrono::steady_clock::now();
+
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(numberThreads)
+        for( size_t i = firstHole; i < numberHoles; i++ )
+            stage( holeOrder[ i ] );
+
+        recordTime( name, start );
+    };
+
+    // The holes large enough for the parallel triangulation use all the
+    // threads, one after the other
+    auto start = std::chrono::steady_clock::now();
+    size_t firstHole = 0;
+
+    while( numberThreads > 1 && firstHole < numberHoles &&
+           _boundaries[ holeOrder[ firstHole ] ].size() >= ( size_t )HoleTriangulator::getParallelThreshold() )
+        triangulateHole( holeOrder[ firstHole++ ] );
+
+    if( firstHole > 0 )
+        recordTime( "Triangulation of " + std::to_string( firstHole ) + " large holes", start );
+
+    runStage( "Triangulation", triangulateHole, firstHole );
+
+    runStage( "Refinement", [ & ]( size_t iHole )
+    {
+        if( refinedCornerTables[ iHole ] )
+            return;
+
+        HoleStatistics& statistics = _holeStatistics[ iHole ];
+        TRACE_SCOPE_ARGUMENT( "refine hole", "vertices", _boundaries[ iHole ].size() );
+        auto start = std::chrono::steady_clock::now();
+
+        refinedCornerTables[ iHole ] = calculateRefinedPatchMesh( _patchCornerTables[ iHole ], _boundaries[ iHole ],
+                                                                  &statistics.refinementRounds );
+
+        auto stop = std::chrono::steady_clock::now();
+        statistics.refinementMilliseconds = std::chrono::duration< double, std::milli >( stop - start ).count();
+        statistics.refinedVertices = refinedCornerTables[ iHole ]->getNumberVertices();
+        statistics.refinedTriangles = refinedCornerTables[ iHole ]->getNumTriangles();
+    }, 0 );
+
+    for( size_t iHole = 0; iHole < numberHoles; iHole++ )
+        _stageCache[ getStageKey( _boundaries[ iHole ] ) ] = { _patchCornerTables[ iHole ], refinedCornerTables[ iHole ], _holeStatistics[ iHole ] };
+
+    runStage( "Fairing", [ & ]( size_t iHole )
+    {
+        TRACE_SCOPE_ARGUMENT( "fair hole", "vertices", _boundaries[ iHole ].size() );
+
+        fairedCornerTables[ iHole ] = calculateFairedPatchMesh( refinedCornerTables[ iHole ], _boundaries[ iHole ],
+                                                                 &_holeStatistics[ iHole ].fairing );
+    }, 0 );
+
+    for( size_t iHole = 0; iHole < numberHoles; iHole++ )
+    {
+        HoleStatistics& statistics = _holeStatistics[ iHole ];
+
+        size_t refinementBytes = 0;
+
+        for( const PatchRefiner::RoundStatistics& round : statistics.refinementRounds )
+            refinementBytes = std::max( refinementBytes, round.bytes );
+
+        statistics.bytes = statistics.triangulation.bytes + refinementBytes + statistics.fairing.bytes +
+            _patchCornerTables[ iHole ]->getAllocatedBytes() + refinedCornerTables[ iHole ]->getAllocatedBytes() +
+            fairedCornerTables[ iHole ]->getAllocatedBytes();
+
+        if( _fairingMode != NONE )
+        {
+            std::cout << "  Hole " << iHole << " (" << fairedCornerTables[ iHole ]->getNumberVertices()
+                      << " vertices): " << statistics.fairing.iterations << " iterations, residual "
+                      << statistics.fairing.residual << ", " << statistics.fairing.milliseconds
+                      << " ms" << std::endl;
+        }
+    }
+
+    // Completed mesh: the patches share the vertices of the boundaries, so
+    // each one is appended and stitched by its seam only
+    start = std::chrono::steady_clock::now();
+
+    {
+        TRACE_SCOPE( "Stitching" );
+        CornerType numberTriangles = _cornerTable->getNumTriangles();
+        CornerType numberVertices = _cornerTable->getNumberVertices();
+
+        for( size_t iHole = 0; iHole < numberHoles; iHole++ )
+        {
+            numberTriangles += fairedCornerTables[ iHole ]->getNumTriangles();
+            numberVertices += fairedCornerTables[ iHole ]->getNumberVertices() - _boundaries[ iHole ].size();
+        }
+
+        _cornerTable->reserve( numberTriangles, numberVertices );
+
+        for( size_t iHole = 0; iHole < numberHoles; iHole++ )
+        {
+            // The holes that could not be triangulated are left open
+            if( fairedCornerTables[ iHole ]->getNumTriangles() == 0 )
+                continue;
+
+            if( !_cornerTable->stitchPatch( *fairedCornerTables[ iHole ], _boundaries[ iHole ] ) )
+                std::cout << "Could not stitch the hole with " << _boundaries[ iHole ].size() << " vertices" << std::endl;
+        }
+
+        _isFilled = true;
+    }
+
+    recordTime( "Stitching", start );
+
+    omp_set_num_threads( defaultNumberThreads );
+}
+
+std::shared_ptr< CornerTable > HoleFiller::getMesh() const
+{
+    return _cornerTable;
+}
+
+const std::vector< HoleBoundary >& HoleFiller::getBoundaries() const
+{
+    return _boundaries;
+}
+
+std::shared_ptr< CornerTable > HoleFiller::getPatchMesh( size_t iHole ) const
+{
+    return _patchCornerTables[ iHole ];
+}
+
+const HoleFiller::HoleStatistics& HoleFiller::getHoleStatistics( size_t iHole ) const
+{
+    return _holeStatistics[ iHole ];
+}
+
+bool HoleFiller::writeStatisticsJSON( const std::string& filename ) const
+{
+    std::ofstream file( filename );
+
+    if( !file )
+    {
+        std::cout << "Could not open " << filename << std::endl;
+        return false;
+    }
+
+    file << "{\n  \"holes\": [";
+
+    for( size_t iHole = 0; iHole < _holeStatistics.size(); iHole++ )
+    {
+        const HoleStatistics& statistics = _holeStatistics[ iHole ];
+
+        file << ( iHole > 0 ? "," : "" ) << "\n    {\"hole\": " << iHole
+             << ", \"boundary_vertices\": " << statistics.boundaryVertices
+             << ", \"boundary_length\": " << statistics.boundaryLength
+             << ", \"pairs\": " << statistics.triangulation.pairs
+             << ", \"candidates\": " << statistics.triangulation.candidates
+             << ", \"patch_triangles\": " << statistics.patchTriangles
+             << ", \"refinement_rounds\": [";
+
+        for( size_t iRound = 0; iRound < statistics.refinementRounds.size(); iRound++ )
+        {
+            const PatchRefiner::RoundStatistics& round = statistics.refinementRounds[ iRound ];
+
+            file << ( iRound > 0 ? ", " : "" ) << "{\"splits\": " << round.splits << ", \"checks\": " << round.checks
+                 << ", \"flips\": " << round.flips << ", \"complete\": " << ( round.isComplete ? "true" : "false" ) << "}";
+        }
+
+        file << "], \"refined_vertices\": " << statistics.refinedVertices
+             << ", \"refined_triangles\": " << statistics.refinedTriangles
+             << ", \"fairing_iterations\": " << statistics.fairing.iterations
+             << ", \"fairing_residual\": " << statistics.fairing.residual
+             << ", \"bytes\": " << statistics.bytes
+             << ", \"triangulation_ms\": " << statistics.triangulationMilliseconds
+             << ", \"refinement_ms\": " << statistics.refinementMilliseconds
+             << ", \"fairing_ms\": " << statistics.fairing.milliseconds << "}";
+    }
+
+    file << "\n  ]\n}\n";
+
+    return ( bool )file;
+}
+
+bool HoleFiller::writeStatisticsCSV( const std::string& filename ) const
+{
+    std::ofstream file( filename );
+
+    if( !file )
+    {
+        std::cout << "Could not open " << filename << std::endl;
+        return false;
+    }
+
+    file << "hole,boundary_vertices,boundary_length,pairs,candidates,patch_triangles,refinement_rounds,splits,checks,"
+            "flips,refined_vertices,refined_triangles,fairing_iterations,fairing_residual,bytes,triangulation_ms,"
+            "refinement_ms,fairing_ms\n";
+
+    for( size_t iHole = 0; iHole < _holeStatistics.size(); iHole++ )
+    {
+        const HoleStatistics& statistics = _holeStatistics[ iHole ];
+        PatchRefiner::RoundStatistics total;
+
+        for( const PatchRefiner::RoundStatistics& round : statistics.refinementRounds )
+        {
+            total.splits += round.splits;
+            total.checks += round.checks;
+            total.flips += round.flips;
+        }
+
+        file << iHole << "," << statistics.boundaryVertices << "," << statistics.boundaryLength << ","
+             << statistics.triangulation.pairs << "," << statistics.triangulation.candidates << ","
+             << statistics.patchTriangles << "," << statistics.refinementRounds.size() << "," << total.splits << ","
+             << total.checks << "," << total.flips << "," << statistics.refinedVertices << ","
+             << statistics.refinedTriangles << "," << statistics.fairing.iterations << ","
+             << statistics.fairing.residual << "," << statistics.bytes << ","
+             << statistics.triangulationMilliseconds << "," << statistics.refinementMilliseconds << ","
+             << statistics.fairing.milliseconds << "\n";
+    }
+
+    return ( bool )file;
+}
+
+std::shared_ptr< CornerTable > HoleFiller::getCompletedMesh() const
+{
+    return _isFilled ? _cornerTable : nullptr;
+}
+
+const std::vector< HoleFiller::StageTime >& HoleFiller::getStageTimes() const
+{
+    return _stageTimes;
+}
+
+HoleFiller::StageKey HoleFiller::getStageKey( const HoleBoundary& boundary ) const
+{
+    return StageKey( boundary, ( CornerType )boundary.size() >= HoleTriangulator::getApproximateThreshold() );
+}
+
+void HoleFiller::calculateHoleBoundaries()
+{
+    _boundaries = _cornerTable->computeBorderLoops();
+}
+
+HoleBoundary HoleFiller::calculateMinimumPatchMesh( const HoleBoundary& boundary, HoleTriangulator::Statistics* statistics )
+{
+    HoleTriangulator triangulator( _cornerTable );
+    HoleBoundary triangles = triangulator.triangulate( boundary );
+
+    if( statistics )
+        *statistics = triangulator.getStatistics();
+
+    return triangles;
+}
+
+std::shared_ptr< CornerTable > HoleFiller::calculatePatchMesh( const HoleBoundary& boundary, const HoleBoundary& triangles )
+{
+    std::vector< double > vertices;
+    vertices.reserve( 3 * boundary.size() );
+
+    for( auto iVertex : boundary )
+    {
+        vertices.push_back( _cornerTable->getAttributes()[ 3 * iVertex ] );
+        vertices.push_back( _cornerTable->getAttributes()[ 3 * iVertex + 1 ] );
+        vertices.push_back( _cornerTable->getAttributes()[ 3 * iVertex + 2 ] );
+    }
+
+    return std::make_shared< CornerTable >( triangles.data(), vertices.data(), triangles.size() / 3,
+                                            vertices.size() / 3, 3 );
+}
+
+std::shared_ptr< CornerTable > HoleFiller::calculateRefinedPatchMesh( std::shared_ptr< CornerTable > patchMesh, const HoleBoundary& boundary,
+                                                                      std::vector< PatchRefiner::RoundStatistics >* statistics )
+{
+    std::vector< double > scaleAttributes;
+
+    for( auto iVertex : boundary )
+        scaleAttributes.push_back( _vertexAverageEdgeLengths[ iVertex ] );
+
+    auto refinedMesh = std::make_shared< CornerTable >( *patchMesh );
+
+    PatchRefiner refiner( refinedMesh, boundary.size() );
+    refiner.refine( scaleAttributes );
+
+    if( statistics )
+        *statistics = refiner.getStatistics();
+
+    return refinedMesh;
+}
+
+std::shared_ptr< CornerTable > HoleFiller::calculateFairedPatchMesh( std::shared_ptr< CornerTable > refinedMesh, const HoleBoundary& boundary,
+                                                                     PatchRefiner::FairingStatistics* statistics )
+{
+    auto fairedMesh = std::make_shared< CornerTable >( *refinedMesh );
+
+    PatchRefiner refiner( fairedMesh, boundary.size() );
+
+    if( _fairingMode == SCALAR )
+        refiner.fair( PatchRefiner::SCALAR );
+    else if( _fairingMode == HARMONIC )
+        refiner.fair( PatchRefiner::HARMONIC );
+    else if( _fairingMode == SECOND_ORDER )
+        refiner.fair( PatchRefiner::SECOND_ORDER );
+
+    if( statistics )
+        *statistics = refiner.getFairingStatistics();
+
+    return fairedMesh;
+}
@@ -0,0 +1,248 @@
+/*
+ * File:   HoleFiller.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef HOLEFILLER_H
+#define HOLEFILLER_H
+
+#include "CornerTable.h"
+#include "HoleTriangulator.h"
+#include "PatchRefiner.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <map>
+#include <utility>
+
+/**@class HoleFiller
+ * Completion of all the holes of a mesh, without any rendering: the hole
+ * boundaries are detected, then each hole is triangulated, refined and faired,
+ * and the faired patches are stitched into the mesh itself. Each stage runs
+ * on all the holes before the next one, the holes taken one at a time by the
+ * free threads, largest first.
+ *
+ * The triangulation and the refinement do not depend on the fairing mode, so
+ * they are kept by hole boundary and triangulation parameters, and reused
+ * when the holes are filled again with another mode.
+ */
+class HoleFiller
+{
+public:
+
+    enum FairingMode
+    {
+        NONE = 0,
+        SCALAR,
+        HARMONIC,
+        SECOND_ORDER
+    };
+
+    /**
+     * Wall time of a stage of the last fill.
+     */
+    struct StageTime
+    {
+        std::string name;
+        double milliseconds;
+    };
+
+    /**
+     * Counters of the completion of a hole, to relate its cost to its size.
+     */
+    struct HoleStatistics
+    {
+        HoleStatistics() : boundaryVertices( 0 ), boundaryLength( 0. ), patchTriangles( 0 ), refinedVertices( 0 ),
+                           refinedTriangles( 0 ), bytes( 0 ), triangulationMilliseconds( 0. ),
+                           refinementMilliseconds( 0. ) { };
+
+        size_t boundaryVertices;
+
+        /**
+         * Sum of the lengths of the boundary edges.
+         */
+        double boundaryLength;
+
+        HoleTriangulator::Statistics triangulation;
+
+        /**
+         * Triangles of the minimum weight patch.
+         */
+        size_t patchTriangles;
+
+        /**
+         * Splits and relaxation of each pass of the refinement that split
+         * triangles. Each pass ends with a relaxation.
+         */
+        std::vector< PatchRefiner::RoundStatistics > refinementRounds;
+
+        size_t refinedVertices, refinedTriangles;
+
+        PatchRefiner::FairingStatistics fairing;
+
+        /**
+         * Memory allocated for the hole: the capacity of the patch meshes,
+         * and the largest work memory of the triangulation, of a pass of
+         * the refinement and of the fairing.
+         */
+        size_t bytes;
+
+        /**
+         * Times of the fill that computed the triangulation and the
+         * refinement, which are reused by the following ones.
+         */
+        double triangulationMilliseconds, refinementMilliseconds;
+    };
+
+    /**
+     * Create a filler for the holes of a mesh. The hole boundaries and the
+     * scale of the vertices are computed here, once.
+     * @param cornerTable - mesh with the holes. The patches are stitched into
+     * it by fill.
+     */
+    HoleFiller( std::shared_ptr< CornerTable > cornerTable );
+
+    virtual ~HoleFiller() {};
+
+    /**
+     * Set the fairing of the next fills. The default is SCALAR.
+     * @param mode - fairing mode.
+     */
+    void setFairingMode( FairingMode mode );
+
+    FairingMode getFairingMode() const;
+
+    /**
+     * Set the number of threads that complete the holes, used as well by the
+     * parallel regions inside each hole during fill.
+     * @param numberThreads - number of threads. Zero uses the OpenMP default.
+     */
+    void setNumberThreads( int numberThreads );
+
+    /**
+     * Triangulate, refine and fair all the holes and stitch the patches into
+     * the mesh, in time linear on the size of the patches. The patches of a
+     * previous fill are removed first. The time of each stage is printed and
+     * kept in getStageTimes.
+     */
+    void fill();
+
+    std::shared_ptr< CornerTable > getMesh() const;
+
+    const std::vector< HoleBoundary >& getBoundaries() const;
+
+    /**
+     * Return the minimum weight patch of a hole from the last fill.
+     * @param iHole - hole, in the order of getBoundaries.
+     * @return - patch mesh, whose first vertices are the boundary vertices.
+     */
+    std::shared_ptr< CornerTable > getPatchMesh( size_t iHole ) const;
+
+    /**
+     * Return the counters of a hole in the last fill.
+     * @param iHole - hole, in the order of getBoundaries.
+     * @return - statistics of the hole. The fairing ones are empty if the
+     * mode is NONE.
+     */
+    const HoleStatistics& getHoleStatistics( size_t iHole ) const;
+
+    /**
+     * Write the counters of all the holes as JSON, the refinement by pass.
+     * @param filename - path of the file.
+     * @return - true if the file was written.
+     */
+    bool writeStatisticsJSON( const std::string& filename ) const;
+
+    /**
+     * Write the counters of all the holes as CSV, one line by hole, with the
+     * refinement passes summed.
+     * @param filename - path of the file.
+     * @return - true if the file was written.
+     */
+    bool writeStatisticsCSV( const std::string& filename ) const;
+
+    /**
+     * Return the mesh with the faired patches stitched into its holes.
+     * @return - the mesh itself, or null before the first fill.
+     */
+    std::shared_ptr< CornerTable > getCompletedMesh() const;
+
+    const std::vector< StageTime >& getStageTimes() const;
+
+    void calculateHoleBoundaries();
+
+    HoleBoundary calculateMinimumPatchMesh( const HoleBoundary& boundary, HoleTriangulator::Statistics* statistics = nullptr );
+
+    /**
+     * Build the patch mesh of a triangulation of a hole.
+     * @param boundary - vertices of the hole.
+     * @param triangles - triangles as triples of positions on the boundary.
+     * @return - patch mesh, whose vertices are the boundary vertices.
+     */
+    std::shared_ptr< CornerTable > calculatePatchMesh( const HoleBoundary& boundary, const HoleBoundary& triangles );
+
+    std::shared_ptr< CornerTable > calculateRefinedPatchMesh( std::shared_ptr< CornerTable > patchMesh, const HoleBoundary& boundary,
+                                                              std::vector< PatchRefiner::RoundStatistics >* statistics = nullptr );
+
+    std::shared_ptr< CornerTable > calculateFairedPatchMesh( std::shared_ptr< CornerTable > refinedMesh, const HoleBoundary& boundary,
+                                                             PatchRefiner::FairingStatistics* statistics = nullptr );
+
+private:
+
+    /**
+     * Results of the stages of a hole that do not depend on the fairing
+     * mode.
+     */
+    struct HoleStages
+    {
+        std::shared_ptr< CornerTable > triangulation;
+        std::shared_ptr< CornerTable > refinement;
+
+        /**
+         * Counters of the triangulation and of the refinement.
+         */
+        HoleStatistics statistics;
+    };
+
+    std::shared_ptr< CornerTable > _cornerTable;
+
+    std::vector< HoleBoundary > _boundaries;
+
+    /**
+     * Hole boundary and whether it is triangulated approximately, the only
+     * parameter that changes the results of the stages. The thread and tile
+     * thresholds and the instruction set give the same results, and the
+     * other inputs, the vertex positions and their scales, belong to the
+     * mesh.
+     */
+    typedef std::pair< HoleBoundary, bool > StageKey;
+
+    StageKey getStageKey( const HoleBoundary& boundary ) const;
+
+    /**
+     * Stage results by hole boundary and parameters.
+     */
+    std::map< StageKey, HoleStages > _stageCache;
+
+    std::vector< double > _vertexAverageEdgeLengths;
+
+    /**
+     * Size of the mesh before the patches of the last fill were appended.
+     */
+    CornerType _numberMeshTriangles, _numberMeshVertices;
+
+    bool _isFilled;
+
+    std::vector< std::shared_ptr< CornerTable > > _patchCornerTables;
+
+    std::vector< HoleStatistics > _holeStatistics;
+
+    std::vector< StageTime > _stageTimes;
+
+    FairingMode _fairingMode;
+
+    int _numberThreads;
+};
+
+#endif /* HOLEFILLER_H */
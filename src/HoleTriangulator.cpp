@@ -0,0 +1,654 @@
+/*
+ * File:   HoleTriangulator.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "HoleTriangulator.h"
+#include "GeometryKernels.h"
+#include "Trace.h"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define HOLE_TRIANGULATOR_X86
+#include <immintrin.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+static inline int omp_get_max_threads( )
+{
+    return 1;
+}
+
+#endif
+
+using namespace std;
+
+//Minimum number of boundary vertices to compute the tables in parallel.
+static CornerType parallelThreshold = 512;
+
+//Minimum number of boundary vertices to compute the tables by tiles.
+static CornerType tiledThreshold = 1024;
+
+//Minimum number of boundary vertices to approximate the triangulation.
+static CornerType approximateThreshold = 4096;
+
+//Number of rows and columns of a tile.
+static const CornerType TILE_SIZE = 64;
+
+// First split m in [begin, end) of the pair (i, k) with the minimum total
+// area: area(i, m) + area(m, k) + area of the triangle (i, m, k), below
+// minArea. The operations and their order are the ones of calculateArea, so
+// the vector version below gives the same totals. distanceI and distanceK are
+// the distances to i and to k.
+static void findMinimumScalar( CornerType begin, CornerType end, const double* distanceI,
+                               const double* distanceK, double sinC, const double* row,
+                               const double* column, double& minArea, CornerType& minIndex )
+{
+    for( CornerType m = begin; m < end; m++ )
+    {
+        double total = ( row[ m ] + column[ m ] ) + 0.5 * distanceI[ m ] * distanceK[ m ] * sinC;
+
+        if( total < minArea )
+        {
+            minArea = total;
+            minIndex = m;
+        }
+    }
+}
+
+#ifdef HOLE_TRIANGULATOR_X86
+
+// Each lane keeps its first minimum, then the smallest of them with the
+// smallest split wins, as in the serial search. Return the first split not
+// evaluated.
+__attribute__( ( target( "avx2" ) ) )
+static CornerType findMinimumAVX2( CornerType begin, CornerType end, const double* distanceI,
+                                   const double* distanceK, double sinC, const double* row,
+                                   const double* column, double& minArea, CornerType& minIndex )
+{
+    __m256d half = _mm256_set1_pd( 0.5 ), sine = _mm256_set1_pd( sinC );
+    __m256d minimum = _mm256_set1_pd( minArea );
+    __m256d index = _mm256_set_pd( begin + 3, begin + 2, begin + 1, begin );
+    __m256d minimumIndex = _mm256_set1_pd( -1 );
+    __m256d step = _mm256_set1_pd( 4 );
+
+    CornerType m = begin;
+
+    for( ; m + 4 <= end; m += 4 )
+    {
+        __m256d a = _mm256_loadu_pd( distanceI + m ), b = _mm256_loadu_pd( distanceK + m );
+
+        __m256d area = _mm256_mul_pd( _mm256_mul_pd( _mm256_mul_pd( half, a ), b ), sine );
+        __m256d sum = _mm256_add_pd( _mm256_loadu_pd( row + m ), _mm256_loadu_pd( column + m ) );
+        __m256d total = _mm256_add_pd( sum, area );
+
+        __m256d isLess = _mm256_cmp_pd( total, minimum, _CMP_LT_OQ );
+        minimum = _mm256_blendv_pd( minimum, total, isLess );
+        minimumIndex = _mm256_blendv_pd( minimumIndex, index, isLess );
+        index = _mm256_add_pd( index, step );
+    }
+
+    double minimums[ 4 ], indexes[ 4 ];
+    _mm256_storeu_pd( minimums, minimum );
+    _mm256_storeu_pd( indexes, minimumIndex );
+
+    for( int lane = 0; lane < 4; lane++ )
+    {
+        if( indexes[ lane ] < 0 )
+            continue;
+
+        if( minimums[ lane ] < minArea || ( minimums[ lane ] == minArea && indexes[ lane ] < minIndex ) )
+        {
+            minArea = minimums[ lane ];
+            minIndex = ( CornerType )indexes[ lane ];
+        }
+    }
+
+    return m;
+}
+
+#endif /* HOLE_TRIANGULATOR_X86 */
+
+HoleTriangulator::HoleTriangulator( std::shared_ptr< CornerTable > cornerTable ) :
+    _cornerTable( cornerTable ),
+    _numberVertices( 0 )
+{
+}
+
+HoleTriangulator::~HoleTriangulator()
+{
+}
+
+const HoleTriangulator::DihedralAngleWeight& HoleTriangulator::getWeight() const
+{
+    return _weight;
+}
+
+const HoleTriangulator::Statistics& HoleTriangulator::getStatistics() const
+{
+    return _statistics;
+}
+
+void HoleTriangulator::setParallelThreshold( const CornerType numberVertices )
+{
+    parallelThreshold = numberVertices;
+}
+
+CornerType HoleTriangulator::getParallelThreshold()
+{
+    return parallelThreshold;
+}
+
+void HoleTriangulator::setTiledThreshold( const CornerType numberVertices )
+{
+    tiledThreshold = numberVertices;
+}
+
+void HoleTriangulator::setApproximateThreshold( const CornerType numberVertices )
+{
+    approximateThreshold = numberVertices;
+}
+
+CornerType HoleTriangulator::getApproximateThreshold()
+{
+    return approximateThreshold;
+}
+
+void HoleTriangulator::loadBoundary( const HoleBoundary& boundary )
+{
+    _boundary = boundary;
+    _numberVertices = ( CornerType )boundary.size();
+
+    CornerType n = _numberVertices;
+
+    _x.resize( n );
+    _y.resize( n );
+    _z.resize( n );
+
+    for( CornerType i = 0; i < n; i++ )
+    {
+        _x[ i ] = _cornerTable->getCoordinate( boundary[ i ], 0 );
+        _y[ i ] = _cornerTable->getCoordinate( boundary[ i ], 1 );
+        _z[ i ] = _cornerTable->getCoordinate( boundary[ i ], 2 );
+    }
+
+    _distances.resize( ( size_t )n * n );
+
+    for( CornerType i = 0; i < n; i++ )
+    {
+        _distances[ ( size_t )i * n + i ] = 0;
+
+        for( CornerType m = i + 1; m < n; m++ )
+        {
+            double dx = _x[ m ] - _x[ i ], dy = _y[ m ] - _y[ i ], dz = _z[ m ] - _z[ i ];
+            double distance = sqrt( dx * dx + dy * dy + dz * dz );
+
+            _distances[ ( size_t )i * n + m ] = distance;
+            _distances[ ( size_t )m * n + i ] = distance;
+        }
+    }
+
+    // Row i holds the pairs (i, k) for k = i, ..., n - 1 and column k the
+    // pairs (m, k) for m = 0, ..., k - 1
+    _rowOffset.resize( n + 1 );
+    _rowOffset[ 0 ] = 0;
+
+    for( CornerType i = 0; i < n; i++ )
+        _rowOffset[ i + 1 ] = _rowOffset[ i ] + ( n - i );
+
+    _areas.assign( _rowOffset[ n ], 0 );
+    _areasByColumn.assign( ( size_t )n * ( n - 1 ) / 2, 0 );
+    _splits.assign( _rowOffset[ n ], -1 );
+}
+
+HoleBoundary HoleTriangulator::triangulate( const HoleBoundary& boundary )
+{
+    if( ( CornerType )boundary.size() >= approximateThreshold )
+        return triangulateApproximate( boundary );
+
+    return triangulateExact( boundary );
+}
+
+HoleBoundary HoleTriangulator::triangulateApproximate( const HoleBoundary& boundary )
+{
+    TRACE_SCOPE_ARGUMENT( "approximate triangulation", "vertices", boundary.size() );
+
+    HoleBoundary triangles;
+
+    if( boundary.size() < 3 )
+    {
+        _weight = DihedralAngleWeight();
+        _statistics = Statistics();
+        return triangles;
+    }
+
+    CornerType n = ( CornerType )boundary.size();
+    CornerType step = ( CornerType )ceil( sqrt( ( double )n ) );
+
+    // Coarse boundary: every step-th vertex and the last one
+    std::vector< CornerType > coarsePositions;
+
+    for( CornerType position = 0; position < n - 1; position += step )
+        coarsePositions.push_back( position );
+
+    coarsePositions.push_back( n - 1 );
+
+    DihedralAngleWeight weight;
+    Statistics statistics;
+
+    auto addStatistics = [ & ]()
+    {
+        weight = weight + _weight;
+        statistics.pairs += _statistics.pairs;
+        statistics.candidates += _statistics.candidates;
+        statistics.bytes = max( statistics.bytes, _statistics.bytes );
+    };
+
+    // A part that could not be triangulated leaves the hole open
+    auto fail = [ & ]()
+    {
+        addStatistics();
+        _weight = DihedralAngleWeight();
+        _statistics = statistics;
+
+        return HoleBoundary();
+    };
+
+    // Each chain between two coarse vertices, closed by the coarse edge
+    for( size_t j = 0; j + 1 < coarsePositions.size(); j++ )
+    {
+        CornerType first = coarsePositions[ j ], last = coarsePositions[ j + 1 ];
+
+        if( last - first < 2 )
+            continue;
+
+        HoleBoundary chain( boundary.begin() + first, boundary.begin() + last + 1 );
+        HoleBoundary chainTriangles = triangulateExact( chain );
+
+        if( chainTriangles.empty() )
+            return fail();
+
+        for( CornerType position : chainTriangles )
+            triangles.push_back( first + position );
+
+        addStatistics();
+    }
+
+    // The coarse polygon
+    if( coarsePositions.size() >= 3 )
+    {
+        HoleBoundary coarse;
+
+        for( CornerType position : coarsePositions )
+            coarse.push_back( boundary[ position ] );
+
+        HoleBoundary coarseTriangles = triangulateExact( coarse );
+
+        if( coarseTriangles.empty() )
+            return fail();
+
+        for( CornerType position : coarseTriangles )
+            triangles.push_back( coarsePositions[ position ] );
+
+        addStatistics();
+    }
+
+    _weight = weight;
+    _statistics = statistics;
+
+    return triangles;
+}
+
+HoleBoundary HoleTriangulator::triangulateExact( const HoleBoundary& boundary )
+{
+    TRACE_SCOPE_ARGUMENT( "exact triangulation", "vertices", boundary.size() );
+
+    _weight = DihedralAngleWeight();
+    _statistics = Statistics();
+
+    HoleBoundary triangles;
+
+    if( boundary.size() < 3 )
+        return triangles;
+
+    {
+        TRACE_SCOPE( "load boundary" );
+        loadBoundary( boundary );
+        loadBoundaryTriangles();
+    }
+
+    CornerType n = _numberVertices;
+
+    // Each pair (i, k) with k > i + 1 compares its k - i - 1 splits
+    _statistics.pairs = ( size_t )( n - 1 ) * ( n - 2 ) / 2;
+    _statistics.candidates = ( size_t )n * ( n - 1 ) * ( n - 2 ) / 6;
+    _statistics.bytes = ( _x.capacity() + _y.capacity() + _z.capacity() + _distances.capacity() + _areas.capacity() +
+                          _areasByColumn.capacity() + _edgeNormals.capacity() ) * sizeof( double ) +
+                        ( _splits.capacity() + _edgeTriangles.capacity() ) * sizeof( CornerType ) +
+                        _rowOffset.capacity() * sizeof( size_t );
+
+    // Triangles of three consecutive vertices
+    for( CornerType i = 0; i <= n - 3; i++ )
+    {
+        double area = calculateArea( i, i + 1, i + 2 );
+
+        _areas[ rowIndex( i, i + 2 ) ] = area;
+        _areasByColumn[ columnIndex( i, i + 2 ) ] = area;
+        _splits[ rowIndex( i, i + 2 ) ] = i + 1;
+    }
+
+    bool isParallel = omp_get_max_threads( ) > 1 && n >= parallelThreshold;
+
+    if( n >= tiledThreshold )
+        computeByTiles( isParallel );
+    else
+        computeBySpan( isParallel );
+
+    {
+        TRACE_SCOPE( "trace" );
+
+        if( !trace( triangles ) )
+            return HoleBoundary();
+    }
+
+    return triangles;
+}
+
+void HoleTriangulator::computeBySpan( bool isParallel )
+{
+    TRACE_SCOPE( "pairs by span" );
+    CornerType n = _numberVertices;
+
+    for( CornerType j = 3; j <= n - 1; j++ )
+    {
+        #pragma omp parallel for schedule(static) if(isParallel)
+        for( CornerType i = 0; i <= n - j - 1; i++ )
+            computePair( i, i + j );
+    }
+}
+
+void HoleTriangulator::computeByTiles( bool isParallel )
+{
+    TRACE_SCOPE( "pairs by tiles" );
+    CornerType n = _numberVertices;
+    CornerType numberTiles = ( n + TILE_SIZE - 1 ) / TILE_SIZE;
+
+    // The pair (i, k) needs (i, m) and (m, k): the tiles on its left and below
+    // it. The tiles (ti, ti + d) of a diagonal d only need the previous
+    // diagonals and are independent.
+    for( CornerType d = 0; d < numberTiles; d++ )
+    {
+        TRACE_SCOPE_ARGUMENT( "tile diagonal", "tiles", numberTiles - d );
+
+        #pragma omp parallel for schedule(dynamic) if(isParallel)
+        for( CornerType ti = 0; ti < numberTiles - d; ti++ )
+        {
+            CornerType firstRow = ti * TILE_SIZE;
+            CornerType lastRow = std::min( firstRow + TILE_SIZE, n ) - 1;
+            CornerType firstColumn = ( ti + d ) * TILE_SIZE;
+            CornerType lastColumn = std::min( firstColumn + TILE_SIZE, n ) - 1;
+
+            // Inside the tile, (i, m) is on a previous column and (m, k) on a
+            // following row
+            for( CornerType k = firstColumn; k <= lastColumn; k++ )
+            {
+                for( CornerType i = std::min( lastRow, k - 3 ); i >= firstRow; i-- )
+                    computePair( i, k );
+            }
+        }
+    }
+}
+
+void HoleTriangulator::computePair( CornerType i, CornerType k )
+{
+    CornerType n = _numberVertices;
+
+    // distanceI[ m ] = |Pm - Pi| and distanceK[ m ] = |Pm - Pk|
+    const double* distanceI = &_distances[ ( size_t )i * n ];
+    const double* distanceK = &_distances[ ( size_t )k * n ];
+    double sinC = sin( distanceI[ k ] );
+
+    // row[ m ] = area( i, m ) and column[ m ] = area( m, k )
+    const double* row = &_areas[ _rowOffset[ i ] - i ];
+    const double* column = &_areasByColumn[ columnIndex( 0, k ) ];
+
+    // The first minimum wins, as in the serial comparison of the weights
+    CornerType minIndex = -1;
+    double minArea = DBL_MAX;
+
+    CornerType m = i + 1;
+
+#ifdef HOLE_TRIANGULATOR_X86
+    if( GeometryKernels::getInstructionSet() == GeometryKernels::AVX2 )
+        m = findMinimumAVX2( m, k, distanceI, distanceK, sinC, row, column, minArea, minIndex );
+#endif
+
+    findMinimumScalar( m, k, distanceI, distanceK, sinC, row, column, minArea, minIndex );
+
+    _areas[ rowIndex( i, k ) ] = minArea;
+    _areasByColumn[ columnIndex( i, k ) ] = minArea;
+    _splits[ rowIndex( i, k ) ] = minIndex;
+}
+
+double HoleTriangulator::calculateArea( CornerType i, CornerType j, CornerType k ) const
+{
+    double dx = _x[ j ] - _x[ i ], dy = _y[ j ] - _y[ i ], dz = _z[ j ] - _z[ i ];
+    double a = sqrt( dx * dx + dy * dy + dz * dz );
+
+    dx = _x[ j ] - _x[ k ], dy = _y[ j ] - _y[ k ], dz = _z[ j ] - _z[ k ];
+    double b = sqrt( dx * dx + dy * dy + dz * dz );
+
+    dx = _x[ k ] - _x[ i ], dy = _y[ k ] - _y[ i ], dz = _z[ k ] - _z[ i ];
+    double c = sqrt( dx * dx + dy * dy + dz * dz );
+
+    return 0.5 * a * b * sin( c );
+}
+
+void HoleTriangulator::calculateNormal( CornerType va, CornerType vb, CornerType vc, double* normal ) const
+{
+    const CornerTable& mesh = *_cornerTable;
+
+    double e1x = mesh.getCoordinate( vb, 0 ) - mesh.getCoordinate( va, 0 );
+    double e1y = mesh.getCoordinate( vb, 1 ) - mesh.getCoordinate( va, 1 );
+    double e1z = mesh.getCoordinate( vb, 2 ) - mesh.getCoordinate( va, 2 );
+    double e2x = mesh.getCoordinate( vc, 0 ) - mesh.getCoordinate( va, 0 );
+    double e2y = mesh.getCoordinate( vc, 1 ) - mesh.getCoordinate( va, 1 );
+    double e2z = mesh.getCoordinate( vc, 2 ) - mesh.getCoordinate( va, 2 );
+
+    normal[ 0 ] = e1y * e2z - e1z * e2y;
+    normal[ 1 ] = e1z * e2x - e1x * e2z;
+    normal[ 2 ] = e1x * e2y - e1y * e2x;
+}
+
+double HoleTriangulator::calculateDihedralAngle( const double* normal1, const double* normal2 ) const
+{
+    return acos( normal1[ 0 ] * normal2[ 0 ] + normal1[ 1 ] * normal2[ 1 ] + normal1[ 2 ] * normal2[ 2 ] );
+}
+
+CornerType HoleTriangulator::findCommonTriangle( CornerType a, CornerType b ) const
+{
+    CornerType c1 = _cornerTable->vertexToCornerIndex( _boundary[ a ] );
+    CornerType c2 = _cornerTable->vertexToCornerIndex( _boundary[ b ] );
+
+    for( CornerType n1 : _cornerTable->getCornerStar( c1 ) )
+    {
+        for( CornerType n2 : _cornerTable->getCornerStar( c2 ) )
+        {
+            if( _cornerTable->cornerTriangle( n1 ) == _cornerTable->cornerTriangle( n2 ) )
+                return _cornerTable->cornerTriangle( n1 );
+        }
+    }
+
+    return CornerTable::BORDER_CORNER;
+}
+
+void HoleTriangulator::loadBoundaryTriangles()
+{
+    CornerType n = _numberVertices;
+
+    _edgeTriangles.resize( n );
+    _edgeNormals.resize( 3 * ( size_t )n );
+
+    // Edge p is (p, p + 1), and the last one closes the boundary
+    for( CornerType p = 0; p < n; p++ )
+    {
+        CornerType t = ( p < n - 1 ) ? findCommonTriangle( p, p + 1 ) : findCommonTriangle( 0, n - 1 );
+
+        _edgeTriangles[ p ] = t;
+
+        if( t != CornerTable::BORDER_CORNER )
+        {
+            calculateNormal( _cornerTable->cornerToVertexIndex( 3 * t ), _cornerTable->cornerToVertexIndex( 3 * t + 1 ),
+                             _cornerTable->cornerToVertexIndex( 3 * t + 2 ), &_edgeNormals[ 3 * p ] );
+        }
+    }
+}
+
+double HoleTriangulator::calculateAngle( CornerType i, CornerType j, CornerType k ) const
+{
+    bool hasAngle = false;
+    double angle = 0;
+
+    double normal[ 3 ];
+    calculateNormal( _boundary[ i ], _boundary[ j ], _boundary[ k ], normal );
+
+    // Angle against the mesh triangle on the other side of the boundary edge
+    auto addMeshTriangle = [ & ]( CornerType edge )
+    {
+        if( _edgeTriangles[ edge ] == CornerTable::BORDER_CORNER )
+            return;
+
+        double meshAngle = calculateDihedralAngle( normal, &_edgeNormals[ 3 * edge ] );
+
+        angle = hasAngle ? DihedralAngleWeight::maximumAngle( angle, meshAngle ) : meshAngle;
+        hasAngle = true;
+    };
+
+    // Angle against the triangle of the patch on the other side of (a, b)
+    auto addSide = [ & ]( CornerType a, CornerType b )
+    {
+        if( b == a + 1 )
+        {
+            addMeshTriangle( a );
+            return;
+        }
+
+        double patchNormal[ 3 ];
+        calculateNormal( _boundary[ a ], _boundary[ _splits[ rowIndex( a, b ) ] ], _boundary[ b ], patchNormal );
+
+        double patchAngle = calculateDihedralAngle( normal, patchNormal );
+
+        angle = hasAngle ? DihedralAngleWeight::maximumAngle( angle, patchAngle ) : patchAngle;
+        hasAngle = true;
+    };
+
+    addSide( i, j );
+    addSide( j, k );
+
+    if( i == 0 && k == _numberVertices - 1 && !( j == i + 1 && k == j + 1 ) )
+        addMeshTriangle( _numberVertices - 1 );
+
+    return angle;
+}
+
+bool HoleTriangulator::trace( HoleBoundary& triangles )
+{
+    struct Node
+    {
+        CornerType i, k, split;
+        int left, right;
+        double angle;
+    };
+
+    CornerType n = _numberVertices;
+
+    // Triangles of the solution, parents before children
+    std::vector< Node > nodes;
+    nodes.push_back( Node{ 0, n - 1, -1, -1, -1, 0 } );
+
+    for( size_t iNode = 0; iNode < nodes.size(); iNode++ )
+    {
+        CornerType i = nodes[ iNode ].i, k = nodes[ iNode ].k;
+        CornerType s = _splits[ rowIndex( i, k ) ];
+
+        if( s <= i || s >= k )
+        {
+            _weight = DihedralAngleWeight();
+            triangles.clear();
+            return false;
+        }
+
+        nodes[ iNode ].split = s;
+
+        if( s != i + 1 )
+        {
+            nodes[ iNode ].left = ( int )nodes.size();
+            nodes.push_back( Node{ i, s, -1, -1, -1, 0 } );
+        }
+
+        if( s != k - 1 )
+        {
+            nodes[ iNode ].right = ( int )nodes.size();
+            nodes.push_back( Node{ s, k, -1, -1, -1, 0 } );
+        }
+    }
+
+    // Angles of the weight, children before parents. The pairs of consecutive
+    // vertices weigh zero.
+    for( size_t iNode = nodes.size(); iNode-- > 0; )
+    {
+        Node& node = nodes[ iNode ];
+        double angle = calculateAngle( node.i, node.split, node.k );
+
+        if( node.k != node.i + 2 )
+        {
+            double left = node.left >= 0 ? nodes[ node.left ].angle : 0;
+            double right = node.right >= 0 ? nodes[ node.right ].angle : 0;
+
+            angle = DihedralAngleWeight::maximumAngle( DihedralAngleWeight::maximumAngle( left, right ), angle );
+        }
+
+        node.angle = angle;
+    }
+
+    _weight = DihedralAngleWeight( nodes[ 0 ].angle, _areas[ rowIndex( 0, n - 1 ) ] );
+
+    // Triangles in the order of the recursive trace: left pair, split
+    // triangle, right pair
+    std::vector< int > stack = { 0 };
+    std::vector< bool > isExpanded( nodes.size(), false );
+
+    while( !stack.empty() )
+    {
+        int iNode = stack.back();
+        stack.pop_back();
+
+        const Node& node = nodes[ iNode ];
+
+        if( isExpanded[ iNode ] )
+        {
+            triangles.push_back( node.i );
+            triangles.push_back( node.split );
+            triangles.push_back( node.k );
+            continue;
+        }
+
+        isExpanded[ iNode ] = true;
+
+        if( node.right >= 0 )
+            stack.push_back( node.right );
+
+        stack.push_back( iNode );
+
+        if( node.left >= 0 )
+            stack.push_back( node.left );
+    }
+
+    return true;
+}
@@ -0,0 +1,314 @@
+/*
+ * File:   HoleTriangulator.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef HOLETRIANGULATOR_H
+#define HOLETRIANGULATOR_H
+
+#include "CornerTable.h"
+#include <vector>
+#include <memory>
+
+typedef std::vector< CornerType > HoleBoundary;
+
+/**@class HoleTriangulator
+ * Minimum weight triangulation of a hole boundary (Liepa). The dynamic
+ * programming state lives in dense triangular tables: the weight of each
+ * (i, k) pair by row and a copy by column, so the candidate splits m of a
+ * pair read both of their sub weights with unit stride, and the split index
+ * of each pair. The distances between the boundary vertices are computed
+ * once, and the candidates are evaluated 4 at a time with AVX2 when it is
+ * available.
+ *
+ * The choice of the split only compares areas, so the dihedral angle of the
+ * weight is computed on the chosen triangulation only.
+ *
+ * The pairs of the same span are independent. Large boundaries are computed
+ * by several threads, one span after the other, and the largest ones by
+ * square tiles of pairs, one diagonal of tiles after the other, so the rows
+ * and columns read by a tile stay in cache. Both orders give the same result
+ * of the serial one.
+ *
+ * The exact triangulation takes O(n^3) time and O(n^2) memory. Holes from
+ * setApproximateThreshold vertices are triangulated coarse to fine instead:
+ * about sqrt(n) boundary vertices, evenly spaced, are triangulated exactly,
+ * then each boundary chain between two of them is closed by an exact
+ * triangulation of its own, which takes O(n^1.5) time and O(n) memory.
+ */
+class HoleTriangulator
+{
+public:
+
+    class DihedralAngleWeight
+    {
+    public:
+
+        DihedralAngleWeight() { area = 0; angle = 0; };
+
+        DihedralAngleWeight( double an, double ar ) { area = ar; angle = an; };
+
+        double angle, area;
+
+        inline DihedralAngleWeight& operator+( const DihedralAngleWeight& rdaw )
+        {
+            this->area += rdaw.area;
+            this->angle = maximumAngle( this->angle, rdaw.angle );
+            return *this;
+        }
+
+        inline bool operator<( const DihedralAngleWeight& rdaw )
+        {
+            //return ( this->angle < rdaw.angle ) || ( ( this->angle == rdaw.angle ) && ( this->area < rdaw.area ) );
+            return ( this->area < rdaw.area );
+        }
+
+        /**
+         * Maximum of two angles. A NaN on the left side is replaced by the
+         * right one.
+         */
+        static inline double maximumAngle( double a, double b )
+        {
+            return ( a > b ) ? a : b;
+        }
+    };
+
+    /**
+     * Work of a triangulation.
+     */
+    struct Statistics
+    {
+        Statistics() : pairs( 0 ), candidates( 0 ), bytes( 0 ) { };
+
+        /**
+         * Pairs (i, k) computed, the cells of the dynamic programming.
+         */
+        size_t pairs;
+
+        /**
+         * Splits m compared, over all the pairs.
+         */
+        size_t candidates;
+
+        /**
+         * Memory of the tables, the largest of the exact triangulations.
+         */
+        size_t bytes;
+    };
+
+    /**
+     * Create a triangulator for the holes of a mesh.
+     * @param cornerTable - mesh with the holes.
+     */
+    HoleTriangulator( std::shared_ptr< CornerTable > cornerTable );
+
+    virtual ~HoleTriangulator();
+
+    /**
+     * Compute the minimum weight triangulation of a hole, exact or
+     * approximate according to its size.
+     * @param boundary - vertices of the hole, in the order of
+     * MeshCompletionApplication::calculateHoleBoundaries.
+     * @return - triangles as triples of positions on the boundary, or an
+     * empty list if the boundary has less than 3 vertices or could not be
+     * triangulated.
+     */
+    HoleBoundary triangulate( const HoleBoundary& boundary );
+
+    /**
+     * Compute the exact minimum weight triangulation of a hole.
+     * @param boundary - vertices of the hole.
+     * @return - triangles as triples of positions on the boundary, or an
+     * empty list if the boundary has less than 3 vertices or could not be
+     * triangulated.
+     */
+    HoleBoundary triangulateExact( const HoleBoundary& boundary );
+
+    /**
+     * Compute a coarse to fine approximation of the minimum weight
+     * triangulation of a hole. Its weight angle does not include the angles
+     * across the edges between the coarse and the fine triangulations.
+     * @param boundary - vertices of the hole.
+     * @return - triangles as triples of positions on the boundary, or an
+     * empty list if the boundary has less than 3 vertices or could not be
+     * triangulated.
+     */
+    HoleBoundary triangulateApproximate( const HoleBoundary& boundary );
+
+    /**
+     * Return the weight of the last triangulation.
+     * @return - sum of the areas and maximum dihedral angle.
+     */
+    const DihedralAngleWeight& getWeight() const;
+
+    /**
+     * Return the work of the last triangulation.
+     * @return - cells, candidates and memory of the tables.
+     */
+    const Statistics& getStatistics() const;
+
+    /**
+     * Set the minimum number of boundary vertices for which the tables are
+     * computed by several threads. The number of threads is the OpenMP
+     * default.
+     * @param numberVertices - minimum number of vertices. Zero always uses
+     * the parallel computation.
+     */
+    static void setParallelThreshold( const CornerType numberVertices );
+
+    /**
+     * Return the minimum number of boundary vertices for which the tables
+     * are computed by several threads.
+     * @return - minimum number of vertices.
+     */
+    static CornerType getParallelThreshold();
+
+    /**
+     * Set the minimum number of boundary vertices for which the pairs are
+     * computed by tiles instead of by span.
+     * @param numberVertices - minimum number of vertices.
+     */
+    static void setTiledThreshold( const CornerType numberVertices );
+
+    /**
+     * Set the minimum number of boundary vertices for which triangulate
+     * computes the approximate triangulation.
+     * @param numberVertices - minimum number of vertices.
+     */
+    static void setApproximateThreshold( const CornerType numberVertices );
+
+    /**
+     * Return the minimum number of boundary vertices for which triangulate
+     * computes the approximate triangulation.
+     * @return - minimum number of vertices.
+     */
+    static CornerType getApproximateThreshold();
+
+private:
+
+    /**
+     * Compute the pairs of each span, the pairs of a span in parallel.
+     */
+    void computeBySpan( bool isParallel );
+
+    /**
+     * Compute the pairs by tiles, the tiles of a diagonal in parallel.
+     */
+    void computeByTiles( bool isParallel );
+
+    /**
+     * Copy the boundary positions and allocate the tables.
+     */
+    void loadBoundary( const HoleBoundary& boundary );
+
+    /**
+     * Fill the tables of the pair (i, k), with k > i + 2, from the pairs of
+     * smaller span.
+     */
+    void computePair( CornerType i, CornerType k );
+
+    /**
+     * Return the weight area of the triangle (i, j, k) of the boundary.
+     */
+    double calculateArea( CornerType i, CornerType j, CornerType k ) const;
+
+    /**
+     * Return the weight angle of the triangle (i, j, k) of the boundary,
+     * against the triangles next to it.
+     */
+    double calculateAngle( CornerType i, CornerType j, CornerType k ) const;
+
+    /**
+     * Compute the normal, not normalized, of the triangle (va, vb, vc) of
+     * the mesh.
+     */
+    void calculateNormal( CornerType va, CornerType vb, CornerType vc, double* normal ) const;
+
+    /**
+     * Return the angle between two triangle normals.
+     */
+    double calculateDihedralAngle( const double* normal1, const double* normal2 ) const;
+
+    /**
+     * Return the mesh triangle that has the boundary vertices a and b, or
+     * CornerTable::BORDER_CORNER.
+     */
+    CornerType findCommonTriangle( CornerType a, CornerType b ) const;
+
+    /**
+     * Find the mesh triangle and its normal on the other side of each
+     * boundary edge, once by hole.
+     */
+    void loadBoundaryTriangles();
+
+    /**
+     * Compute the weight angle of the triangulation and list its triangles in
+     * the order of the recursive trace.
+     * @return - false, with no triangles and an empty weight, if a pair has
+     * no valid split.
+     */
+    bool trace( HoleBoundary& triangles );
+
+    inline size_t rowIndex( CornerType i, CornerType k ) const
+    {
+        return _rowOffset[ i ] + ( k - i );
+    }
+
+    inline size_t columnIndex( CornerType m, CornerType k ) const
+    {
+        return ( size_t )k * ( k - 1 ) / 2 + m;
+    }
+
+    std::shared_ptr< CornerTable > _cornerTable;
+
+    HoleBoundary _boundary;
+
+    CornerType _numberVertices;
+
+    /**
+     * Boundary positions, by coordinate.
+     */
+    std::vector< double > _x, _y, _z;
+
+    /**
+     * Distance between each two boundary vertices, as a full symmetric
+     * matrix, so the distances to i and to k are both read by row.
+     */
+    std::vector< double > _distances;
+
+    /**
+     * Mesh triangle on the other side of each boundary edge (p, p + 1), and
+     * of the closing edge (0, n - 1) last, or CornerTable::BORDER_CORNER.
+     */
+    std::vector< CornerType > _edgeTriangles;
+
+    /**
+     * Normal, not normalized, of each triangle of _edgeTriangles.
+     */
+    std::vector< double > _edgeNormals;
+
+    /**
+     * First position of each row of the tables by row.
+     */
+    std::vector< size_t > _rowOffset;
+
+    /**
+     * Area of the best triangulation of each pair (i, k), by row and by
+     * column.
+     */
+    std::vector< double > _areas;
+    std::vector< double > _areasByColumn;
+
+    /**
+     * Best split of each pair (i, k), by row.
+     */
+    std::vector< CornerType > _splits;
+
+    DihedralAngleWeight _weight;
+
+    Statistics _statistics;
+};
+
+#endif /* HOLETRIANGULATOR_H */
+
@@ -237,13 +237,13 @@ gboolean MainWindow::onFairingModeButtonClicked( GtkWidget* button, gpointer poi
     MeshCompletionApplication::FairingMode mode;
     
     if( button == dialog->_scaleFairingButton )
-        mode = MeshCompletionApplication::SCALAR;
+        mode = HoleFiller::SCALAR;
     else if( button == dialog->_harmonicFairingButton )
-        mode = MeshCompletionApplication::HARMONIC;
+        mode = HoleFiller::HARMONIC;
     else if( button == dialog->_secondOrderFairingButton )
-        mode = MeshCompletionApplication::SECOND_ORDER;
+        mode = HoleFiller::SECOND_ORDER;
     else
-        mode = MeshCompletionApplication::NONE;
+        mode = HoleFiller::NONE;
     
     MeshCompletionApplication::getInstance()->setFairingMode( mode );
     
@@ -0,0 +1,76 @@
+/*
+ * File:   MappedFile.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "MappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile( const std::string& fileName ) :
+    _data( nullptr ),
+    _size( 0 ),
+    _isOpen( false )
+{
+    int fd = open( fileName.c_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return;
+
+    struct stat status;
+
+    if( fstat( fd, &status ) == 0 )
+    {
+        _size = ( size_t )status.st_size;
+
+        if( _size == 0 )
+        {
+            _isOpen = true;
+        }
+        else
+        {
+            void* mapping = mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+            if( mapping != MAP_FAILED )
+            {
+                // The whole file is scanned once from the beginning
+                madvise( mapping, _size, MADV_SEQUENTIAL );
+
+                _data = static_cast< const char* >( mapping );
+                _isOpen = true;
+            }
+            else
+            {
+                _size = 0;
+            }
+        }
+    }
+
+    // The mapping remains valid after the descriptor is closed
+    close( fd );
+}
+
+MappedFile::~MappedFile()
+{
+    if( _data )
+        munmap( const_cast< char* >( _data ), _size );
+}
+
+bool MappedFile::isOpen() const
+{
+    return _isOpen;
+}
+
+const char* MappedFile::getData() const
+{
+    return _data;
+}
+
+size_t MappedFile::getSize() const
+{
+    return _size;
+}
@@ -0,0 +1,61 @@
+/*
+ * File:   MappedFile.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/**@class MappedFile
+ * Read-only memory mapping of a whole file. The mapping is released when the
+ * object is destroyed.
+ */
+class MappedFile
+{
+public:
+
+    /**
+     * Map the file in memory. Use isOpen() to verify if it succeeded.
+     * @param fileName - path of the file to be mapped.
+     */
+    MappedFile( const std::string& fileName );
+
+    virtual ~MappedFile();
+
+    /**
+     * Return if the file was successfully mapped.
+     * @return - true if the file is mapped and false otherwise.
+     */
+    bool isOpen() const;
+
+    /**
+     * Return the first byte of the mapped file. It is null for empty files.
+     * @return - pointer to the mapped content.
+     */
+    const char* getData() const;
+
+    /**
+     * Return the size of the mapped file in bytes.
+     * @return - size of the file.
+     */
+    size_t getSize() const;
+
+private:
+
+    MappedFile( const MappedFile& );
+
+    MappedFile& operator=( const MappedFile& );
+
+    const char* _data;
+
+    size_t _size;
+
+    bool _isOpen;
+};
+
+#endif /* MAPPEDFILE_H */
+
@@ -0,0 +1,234 @@
+/*
+ * File:   MeshCache.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "MeshCache.h"
+#include "MappedFile.h"
+
+#include <vector>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint32_t MeshCache::VERSION;
+
+// "MCCT" read as a little endian integer. A file written on a machine with
+// another byte order does not match it.
+static const uint32_t MAGIC = 0x5443434d;
+
+struct CacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t numberCoordinatesByVertex;
+    int64_t numberVertices;
+    int64_t numberTriangles;
+    int64_t numberNonManifoldCorners;
+    uint64_t sourceSize;
+    int64_t sourceModificationTime;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+// Sizes of the tables stored after the header. Each table is padded to a
+// multiple of 8 bytes so that the attributes stay aligned in the mapping.
+struct CacheLayout
+{
+    CacheLayout( int64_t numberVertices, int64_t numberTriangles, uint32_t numberCoordinatesByVertex,
+                 int64_t numberNonManifoldCorners )
+    {
+        triangleBytes = 3 * numberTriangles * sizeof( CornerType );
+        vertexToCornerBytes = numberVertices * sizeof( CornerType );
+        attributeBytes = numberCoordinatesByVertex * numberVertices * sizeof( double );
+        nonManifoldBytes = numberNonManifoldCorners * sizeof( CornerType );
+
+        triangleOffset = 0;
+        oppositeOffset = triangleOffset + padded( triangleBytes );
+        vertexToCornerOffset = oppositeOffset + padded( triangleBytes );
+        attributeOffset = vertexToCornerOffset + padded( vertexToCornerBytes );
+        nonManifoldOffset = attributeOffset + padded( attributeBytes );
+        payloadSize = nonManifoldOffset + padded( nonManifoldBytes );
+    }
+
+    static uint64_t padded( uint64_t bytes )
+    {
+        return ( bytes + 7 ) & ~( uint64_t )7;
+    }
+
+    uint64_t triangleBytes, vertexToCornerBytes, attributeBytes, nonManifoldBytes;
+    uint64_t triangleOffset, oppositeOffset, vertexToCornerOffset, attributeOffset, nonManifoldOffset;
+    uint64_t payloadSize;
+};
+
+// FNV-1a over 64 bit words. The payload size is always a multiple of 8.
+static uint64_t computeChecksum( const char* payload, uint64_t size )
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for( uint64_t i = 0; i < size; i += 8 )
+    {
+        uint64_t word;
+        memcpy( &word, payload + i, 8 );
+
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+MeshCache::MeshCache()
+{
+}
+
+bool MeshCache::getSourceStamp( const std::string& filename, SourceStamp& stamp )
+{
+    struct stat status;
+
+    if( stat( filename.c_str(), &status ) != 0 )
+        return false;
+
+    stamp.size = ( uint64_t )status.st_size;
+    stamp.modificationTime = ( int64_t )status.st_mtim.tv_sec * 1000000000 + status.st_mtim.tv_nsec;
+
+    return true;
+}
+
+std::string MeshCache::getCacheFilename( const std::string& meshFilename )
+{
+    return meshFilename + ".mcc";
+}
+
+bool MeshCache::write( const std::string& filename, const CornerTable& cornerTable, const SourceStamp& stamp )
+{
+    const std::vector< CornerType >& nonManifoldCorners = cornerTable.getNonManifoldCorners();
+    CacheLayout layout( cornerTable.getNumberVertices(), cornerTable.getNumTriangles(),
+                        cornerTable.getNumberAttributesByVertex(), nonManifoldCorners.size() );
+
+    // The payload is assembled in memory to compute its checksum
+    std::vector< char > payload( layout.payloadSize, 0 );
+
+    if( layout.triangleBytes )
+    {
+        memcpy( &payload[ layout.triangleOffset ], cornerTable.getTriangleList(), layout.triangleBytes );
+        memcpy( &payload[ layout.oppositeOffset ], cornerTable.getOppositeList(), layout.triangleBytes );
+    }
+
+    if( layout.vertexToCornerBytes )
+        memcpy( &payload[ layout.vertexToCornerOffset ], cornerTable.getVertexToCornerList(), layout.vertexToCornerBytes );
+
+    if( layout.attributeBytes )
+        memcpy( &payload[ layout.attributeOffset ], cornerTable.getAttributes(), layout.attributeBytes );
+
+    if( layout.nonManifoldBytes )
+        memcpy( &payload[ layout.nonManifoldOffset ], nonManifoldCorners.data(), layout.nonManifoldBytes );
+
+    CacheHeader header;
+    memset( &header, 0, sizeof( header ) );
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.headerSize = sizeof( CacheHeader );
+    header.numberCoordinatesByVertex = cornerTable.getNumberAttributesByVertex();
+    header.numberVertices = cornerTable.getNumberVertices();
+    header.numberTriangles = cornerTable.getNumTriangles();
+    header.numberNonManifoldCorners = nonManifoldCorners.size();
+    header.sourceSize = stamp.size;
+    header.sourceModificationTime = stamp.modificationTime;
+    header.payloadSize = layout.payloadSize;
+    header.checksum = computeChecksum( payload.data(), layout.payloadSize );
+
+    // A unique temporary file in the same directory, so that two loaders of
+    // the same mesh never write the same file and the rename stays atomic
+    std::vector< char > temporaryFilename( filename.begin(), filename.end() );
+    const char* suffix = ".XXXXXX";
+    temporaryFilename.insert( temporaryFilename.end(), suffix, suffix + strlen( suffix ) + 1 );
+
+    int descriptor = mkstemp( temporaryFilename.data() );
+
+    if( descriptor < 0 )
+        return false;
+
+    fchmod( descriptor, 0644 );
+
+    FILE* out = fdopen( descriptor, "wb" );
+
+    if( !out )
+    {
+        close( descriptor );
+        std::remove( temporaryFilename.data() );
+        return false;
+    }
+
+    bool isWritten = fwrite( &header, sizeof( header ), 1, out ) == 1 &&
+        fwrite( payload.data(), 1, payload.size(), out ) == payload.size();
+
+    if( fclose( out ) != 0 || !isWritten )
+    {
+        std::remove( temporaryFilename.data() );
+        return false;
+    }
+
+    if( std::rename( temporaryFilename.data(), filename.c_str() ) != 0 )
+    {
+        std::remove( temporaryFilename.data() );
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr< CornerTable > MeshCache::read( const std::string& filename, const SourceStamp& stamp )
+{
+    MappedFile file( filename );
+
+    if( !file.isOpen() || file.getSize() < sizeof( CacheHeader ) )
+        return nullptr;
+
+    CacheHeader header;
+    memcpy( &header, file.getData(), sizeof( header ) );
+
+    if( header.magic != MAGIC || header.version != VERSION || header.headerSize != sizeof( CacheHeader ) )
+        return nullptr;
+
+    if( header.sourceSize != stamp.size || header.sourceModificationTime != stamp.modificationTime )
+        return nullptr;
+
+    if( header.numberVertices < 0 || header.numberTriangles < 0 || header.numberCoordinatesByVertex == 0 ||
+        header.numberNonManifoldCorners < 0 || header.numberNonManifoldCorners > 3 * header.numberTriangles )
+        return nullptr;
+
+    CacheLayout layout( header.numberVertices, header.numberTriangles, header.numberCoordinatesByVertex,
+                        header.numberNonManifoldCorners );
+
+    if( layout.payloadSize != header.payloadSize || file.getSize() != sizeof( CacheHeader ) + layout.payloadSize )
+        return nullptr;
+
+    const char* payload = file.getData() + sizeof( CacheHeader );
+
+    if( computeChecksum( payload, layout.payloadSize ) != header.checksum )
+        return nullptr;
+
+    const CornerType* triangles = reinterpret_cast< const CornerType* >( payload + layout.triangleOffset );
+    const CornerType* opposites = reinterpret_cast< const CornerType* >( payload + layout.oppositeOffset );
+    const CornerType* vertexToCorner = reinterpret_cast< const CornerType* >( payload + layout.vertexToCornerOffset );
+    const double* attributes = reinterpret_cast< const double* >( payload + layout.attributeOffset );
+    const CornerType* nonManifold = reinterpret_cast< const CornerType* >( payload + layout.nonManifoldOffset );
+
+    // The tables are copied out of the mapping, since the Corner Table owns
+    // and grows them
+    size_t nCorners = 3 * header.numberTriangles;
+    size_t nAttributes = header.numberCoordinatesByVertex * header.numberVertices;
+
+    return std::make_shared< CornerTable >(
+        std::vector< CornerType >( triangles, triangles + nCorners ),
+        std::vector< CornerType >( opposites, opposites + nCorners ),
+        std::vector< CornerType >( vertexToCorner, vertexToCorner + header.numberVertices ),
+        std::vector< double >( attributes, attributes + nAttributes ),
+        header.numberCoordinatesByVertex,
+        std::vector< CornerType >( nonManifold, nonManifold + header.numberNonManifoldCorners ) );
+}
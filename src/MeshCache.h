@@ -0,0 +1,83 @@
+/*
+ * File:   MeshCache.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include "CornerTable.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+
+/**@class MeshCache
+ * Binary image of a CornerTable. The file holds a fixed header followed by
+ * the raw V table, O table, vertex to corner table, attributes and list of
+ * non-manifold corners, so it can be loaded back without parsing or
+ * rebuilding the adjacency. It is a copy-on-load cache: the file is mapped
+ * and its tables are copied into the Corner Table, which owns them. The header
+ * stores a format version, a checksum of the tables and the size and
+ * modification time of the mesh file it was built from.
+ */
+class MeshCache
+{
+public:
+
+    /**
+     * Identification of the source file of a cache. A cache is only used if
+     * the stamp stored in it matches the current source file.
+     */
+    struct SourceStamp
+    {
+        SourceStamp() : size( 0 ), modificationTime( 0 ) {};
+
+        uint64_t size;
+        int64_t modificationTime;
+    };
+
+    MeshCache();
+
+    virtual ~MeshCache() {};
+
+    /**
+     * Write the Corner Table on a binary file. The file is written on a
+     * unique temporary name in the same directory and renamed, so a partially
+     * written cache is never read, even if several processes write it.
+     * @param filename - cache file path.
+     * @param cornerTable - mesh to be stored.
+     * @param stamp - stamp of the source mesh file.
+     * @return - true if the file was written.
+     */
+    bool write( const std::string& filename, const CornerTable& cornerTable, const SourceStamp& stamp );
+
+    /**
+     * Map a cache file and build the Corner Table from a copy of its tables.
+     * @param filename - cache file path.
+     * @param stamp - expected stamp of the source mesh file.
+     * @return - the mesh or nullptr if the file is missing, stale, of another
+     * version or corrupted.
+     */
+    std::shared_ptr< CornerTable > read( const std::string& filename, const SourceStamp& stamp );
+
+    /**
+     * Return the stamp of a file.
+     * @param filename - file path.
+     * @param stamp - filled with the size and modification time of the file.
+     * @return - false if the file does not exist.
+     */
+    static bool getSourceStamp( const std::string& filename, SourceStamp& stamp );
+
+    /**
+     * Return the path of the sidecar cache of a mesh file.
+     * @param meshFilename - path of the mesh file.
+     * @return - path of the cache file, next to the mesh file.
+     */
+    static std::string getCacheFilename( const std::string& meshFilename );
+
+    static const uint32_t VERSION = 2;
+};
+
+#endif /* MESHCACHE_H */
+
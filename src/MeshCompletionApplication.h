@@ -10,49 +10,20 @@
 
 #include "MainWindow.h"
 #include "CornerTable.h"
+#include "HoleTriangulator.h"
+#include "HoleFiller.h"
 #include "MeshGeometry.h"
 #include "WireframeGeometry.h"
 #include "BoundaryGeometry.h"
 #include <memory>
-#include "TriMesh.h"
-    
-typedef std::vector< CornerType > HoleBoundary;
 
 class MeshCompletionApplication 
 {
 public:
         
-    class DihedralAngleWeight
-    {
-    public:
-        
-        DihedralAngleWeight() { area = 0; angle = 0; };
-        
-        DihedralAngleWeight( double an, double ar ) { area = ar; angle = an; };
-        
-        double angle, area;
-        
-        inline DihedralAngleWeight& operator+( const DihedralAngleWeight& rdaw )
-        {
-            this->area += rdaw.area;
-            this->angle = MAX( this->angle, rdaw.angle );
-            return *this;
-        }
-        
-        inline bool operator<( const DihedralAngleWeight& rdaw )
-        {
-            //return ( this->angle < rdaw.angle ) || ( ( this->angle == rdaw.angle ) && ( this->area < rdaw.area ) );
-            return ( this->area < rdaw.area );
-        }
-    };
-    
-    enum FairingMode
-    {
-        NONE = 0,
-        SCALAR,
-        HARMONIC,
-        SECOND_ORDER
-    };
+    typedef HoleTriangulator::DihedralAngleWeight DihedralAngleWeight;
+    
+    typedef HoleFiller::FairingMode FairingMode;
     
     virtual ~MeshCompletionApplication();
     
@@ -68,31 +39,22 @@ public:
     
     void setFairingMode( FairingMode mode );
     
-    void calculateHoleBoundaries();
+    /**
+     * Set the number of threads that complete the holes.
+     * @param numberThreads - number of threads. Zero uses the OpenMP default.
+     */
+    void setNumberThreads( int numberThreads );
     
-    HoleBoundary calculateMinimumPatchMesh( HoleBoundary boundary );
-        
-    TriMesh calculateRefinedPatchMesh( std::shared_ptr< CornerTable > patchMesh, HoleBoundary boundary );    
+    /**
+     * Return the mesh with the faired patches stitched into its holes.
+     * @return - completed mesh, or null before a mesh is opened.
+     */
+    std::shared_ptr< CornerTable > getCompletedMesh() const;
     
-    std::shared_ptr< CornerTable > calculateFairedPatchMesh( TriMesh& mesh );    
-        
 private:
     
     MeshCompletionApplication();    
     
-    double calculateDihedralAngle( CornerType vi, CornerType vj, CornerType vk,
-                               CornerType vl, CornerType vm, CornerType vn );
-    
-    osg::Vec3 calculateCentroid( std::shared_ptr< CornerTable > patch, CornerType vi, CornerType vj, CornerType vk );
-    
-    //void relaxEdge( std::vector< double >& vertexArray, std::vector< CornerType >& indexArray, CornerType corner );
-    
-    bool isInCircumsphere( TriMesh& mesh, TriMesh::EdgeHandle edge );
-    
-    bool relaxEdge( TriMesh& mesh, TriMesh::EdgeHandle edge );
-    
-    bool relaxAllEdges( TriMesh& mesh );
-    
     static MeshCompletionApplication* _instance;
     
     void buildMesh();
@@ -107,6 +69,11 @@ private:
     
     std::shared_ptr< CornerTable > _cornerTable;
     
+    /**
+     * Completion of the holes of the open mesh.
+     */
+    std::shared_ptr< HoleFiller > _holeFiller;
+    
     osg::ref_ptr< osg::Group > _scene;
     
     osg::ref_ptr< osg::Geode > _meshesGeode;    
@@ -115,16 +82,14 @@ private:
     
     osg::ref_ptr< MeshGeometry > _meshGeometry;    
     osg::ref_ptr< WireframeGeometry > _wireframeGeometry;
-    std::vector< osg::ref_ptr< MeshGeometry > > _patchMeshesGeometry;
-    std::vector< osg::ref_ptr< WireframeGeometry > > _patchWireframesGeometry;
     std::vector< osg::ref_ptr< BoundaryGeometry > > _boundariesGeometry;
     
     bool _isWireframeEnabled;
     bool _isBoundariesEnabled;
     
-    std::vector< HoleBoundary > _boundaries;
-    
     FairingMode _fairingMode;
+    
+    int _numberThreads;
 };
 
 #endif /* MESHCOMPLETIONAPPLICATION_H */
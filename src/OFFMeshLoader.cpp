@@ -1,129 +1,628 @@
-/* 
+/*
  * File:   MeshLoader.cpp
  * Author: allan
- * 
+ *
  * Created on April 11, 2016, 10:36 PM
  */
 
 #include "OFFMeshLoader.h"
-#include <gtk/gtk.h>
-#include <fstream>
+#include "MappedFile.h"
+#include "MeshCache.h"
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
 #include <iostream>
 #include <clocale>
+#include <vector>
+#include <utility>
 #include <algorithm>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
+// Powers of ten exactly representable as doubles
+static const double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const int MAX_VERTEX_VALUES = 16;
+
+// Smallest amount of text handed to a thread by the parallel parser
+static const size_t MIN_CHUNK_SIZE = 64 * 1024;
+
 OFFMeshLoader::OFFMeshLoader() :
-    _currentPath( g_get_current_dir() ) 
+    _parseMode( PARALLEL ),
+    _numberThreads( 0 ),
+    _isCacheEnabled( false )
+{
+}
+
+static inline bool isBlank( char c )
 {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-static size_t countWords( std::string s ) 
-{ 
-    return ((size_t)std::count_if( s.begin(), s.end(), std::ptr_fun <int, int> ( std::isspace ) ) == s.length()) ? 
-        0  : std::count_if( std::find_if( s.begin(), s.end(), 
-            std::not1( std::ptr_fun <int, int> ( std::isspace ) ) ), std::unique( s.begin(), s.end() ), 
-            std::ptr_fun <int, int> ( std::isspace ) ) + !std::isspace( *s.rbegin() ); 
+static inline bool isDigit( char c )
+{
+    return c >= '0' && c <= '9';
 }
 
-std::shared_ptr< CornerTable > OFFMeshLoader::parse( string filename ) 
+static inline bool isTokenEnd( const char* cursor, const char* end )
 {
-    setlocale(LC_ALL, "C");
-            
-    //std::string filePath(_currentPath + "/data/" + filename);
-    std::string filePath( filename );
-    
-    int nv, nf;
-    
-    // Container holding last line read
-    string readLine;
-    // Containers for delimiter positions
-    int delimiterPos_0, delimiterPos_1, delimiterPos_2, delimiterPos_3, delimiterPos_4, delimiterPos_5;
+    return cursor == end || isBlank( *cursor ) || *cursor == '\n' || *cursor == '#';
+}
 
-    // Open file for reading
-    ifstream in(filePath.c_str());
+static inline bool isLineEnd( const char* cursor, const char* end )
+{
+    return cursor == end || *cursor == '\n';
+}
 
-    // Check if file is in OFF format
-    getline(in, readLine);
-    readLine.erase(remove_if(readLine.begin(), readLine.end(), ::isspace), readLine.end());
-    
-    if (readLine != "OFF") {
-        cout << "The file to read is not in OFF format. " << readLine << endl;
-        return 0;
-    }
-
-    // Read values for Nv and Nf
-    getline(in, readLine);
-    delimiterPos_1 = readLine.find(" ", 0);
-    nv = atoi(readLine.substr(0, delimiterPos_1 + 1).c_str());
-    delimiterPos_2 = readLine.find(" ", delimiterPos_1);
-    nf = atoi(readLine.substr(delimiterPos_1, delimiterPos_2 + 1).c_str());
-
-    //Skip linebreak
-    getline(in, readLine);
-    
-    // Read the vertices
-    std::vector< double > vertexes;
-    vertexes.reserve(nv*3);
-    int index = 0;
-    
-    for (int n = 0; n < nv; n++) {        
-        getline(in, readLine);
-        
-        int nNumbers = countWords( readLine );
-        
-        delimiterPos_0 = 0;
-        delimiterPos_1 = readLine.find(" ", 0);
-        
-        if( nNumbers > 3 )
+// Skip blanks, line breaks and comments up to the next token
+static const char* skipToToken( const char* cursor, const char* end )
+{
+    while( cursor < end )
+    {
+        if( *cursor == '#' )
+        {
+            const char* lineBreak = static_cast< const char* >( memchr( cursor, '\n', end - cursor ) );
+            cursor = lineBreak ? lineBreak : end;
+        }
+        else if( isBlank( *cursor ) || *cursor == '\n' )
+        {
+            cursor++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return cursor;
+}
+
+// Skip blanks and a trailing comment without leaving the current line
+static const char* skipInLine( const char* cursor, const char* end )
+{
+    while( cursor < end && isBlank( *cursor ) )
+        cursor++;
+
+    if( cursor < end && *cursor == '#' )
+    {
+        const char* lineBreak = static_cast< const char* >( memchr( cursor, '\n', end - cursor ) );
+        cursor = lineBreak ? lineBreak : end;
+    }
+
+    return cursor;
+}
+
+static const char* skipLine( const char* cursor, const char* end )
+{
+    const char* lineBreak = static_cast< const char* >( memchr( cursor, '\n', end - cursor ) );
+
+    return lineBreak ? lineBreak + 1 : end;
+}
+
+static const char* parseInteger( const char* cursor, const char* end, int& value )
+{
+    bool isNegative = false;
+
+    if( cursor < end && ( *cursor == '-' || *cursor == '+' ) )
+    {
+        isNegative = ( *cursor == '-' );
+        cursor++;
+    }
+
+    if( cursor == end || !isDigit( *cursor ) )
+        return nullptr;
+
+    long long number = 0;
+
+    while( cursor < end && isDigit( *cursor ) )
+    {
+        number = 10 * number + ( *cursor - '0' );
+
+        if( number > INT32_MAX )
+            return nullptr;
+
+        cursor++;
+    }
+
+    if( !isTokenEnd( cursor, end ) )
+        return nullptr;
+
+    value = ( int )( isNegative ? -number : number );
+
+    return cursor;
+}
+
+// Slow path for the tokens the fast path cannot convert exactly
+static const char* parseDoubleFallback( const char* cursor, const char* end, double& value )
+{
+    const char* tokenEnd = cursor;
+
+    while( !isTokenEnd( tokenEnd, end ) )
+        tokenEnd++;
+
+    std::string token( cursor, tokenEnd );
+    char* parsedEnd;
+    value = strtod( token.c_str(), &parsedEnd );
+
+    if( parsedEnd != token.c_str() + token.size() || token.empty() )
+        return nullptr;
+
+    return tokenEnd;
+}
+
+// Decimal to double conversion. Numbers with at most 15 significant digits and
+// small exponents are converted exactly with one multiplication or division
+// (Clinger's fast path); anything else is handed to strtod.
+static const char* parseDouble( const char* cursor, const char* end, double& value )
+{
+    const char* start = cursor;
+    bool isNegative = false;
+
+    if( cursor < end && ( *cursor == '-' || *cursor == '+' ) )
+    {
+        isNegative = ( *cursor == '-' );
+        cursor++;
+    }
+
+    uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    bool isTruncated = false;
+
+    while( cursor < end && isDigit( *cursor ) )
+    {
+        int digit = *cursor - '0';
+        hasDigits = true;
+
+        if( mantissa != 0 || digit != 0 )
+        {
+            if( significantDigits < 19 )
+            {
+                mantissa = 10 * mantissa + digit;
+                significantDigits++;
+            }
+            else
+            {
+                exponent++;
+                isTruncated = true;
+            }
+        }
+
+        cursor++;
+    }
+
+    if( cursor < end && *cursor == '.' )
+    {
+        cursor++;
+
+        while( cursor < end && isDigit( *cursor ) )
+        {
+            int digit = *cursor - '0';
+            hasDigits = true;
+
+            if( mantissa != 0 || digit != 0 )
+            {
+                if( significantDigits < 19 )
+                {
+                    mantissa = 10 * mantissa + digit;
+                    significantDigits++;
+                    exponent--;
+                }
+                else
+                {
+                    isTruncated = true;
+                }
+            }
+            else
+            {
+                exponent--;
+            }
+
+            cursor++;
+        }
+    }
+
+    if( !hasDigits )
+        return parseDoubleFallback( start, end, value );
+
+    if( cursor < end && ( *cursor == 'e' || *cursor == 'E' ) )
+    {
+        cursor++;
+
+        bool isExponentNegative = false;
+
+        if( cursor < end && ( *cursor == '-' || *cursor == '+' ) )
+        {
+            isExponentNegative = ( *cursor == '-' );
+            cursor++;
+        }
+
+        if( cursor == end || !isDigit( *cursor ) )
+            return parseDoubleFallback( start, end, value );
+
+        int explicitExponent = 0;
+
+        while( cursor < end && isDigit( *cursor ) )
+        {
+            if( explicitExponent < 100000 )
+                explicitExponent = 10 * explicitExponent + ( *cursor - '0' );
+
+            cursor++;
+        }
+
+        exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+    }
+
+    if( !isTokenEnd( cursor, end ) )
+        return parseDoubleFallback( start, end, value );
+
+    if( mantissa == 0 )
+    {
+        value = isNegative ? -0. : 0.;
+        return cursor;
+    }
+
+    if( isTruncated || significantDigits > 15 || exponent < -22 || exponent > 22 )
+        return parseDoubleFallback( start, end, value );
+
+    value = ( double )mantissa;
+    value = exponent < 0 ? value / exactPowersOfTen[ -exponent ] : value * exactPowersOfTen[ exponent ];
+
+    if( isNegative )
+        value = -value;
+
+    return cursor;
+}
+
+// Parse a vertex record. The cursor must be at its first token and is left
+// at the end of the line.
+static const char* parseVertex( const char* cursor, const char* end, double* vertex )
+{
+    double values[ MAX_VERTEX_VALUES ];
+    int nValues = 0;
+
+    while( cursor && !isLineEnd( cursor = skipInLine( cursor, end ), end ) )
+    {
+        double value;
+        cursor = parseDouble( cursor, end, value );
+
+        if( nValues < MAX_VERTEX_VALUES )
+            values[ nValues ] = value;
+
+        nValues++;
+    }
+
+    if( !cursor || nValues < 3 )
+        return nullptr;
+
+    // Lines with more than three values start with the vertex index
+    int offset = ( nValues > 3 ) ? 1 : 0;
+
+    vertex[ 0 ] = values[ offset ];
+    vertex[ 1 ] = values[ offset + 1 ];
+    vertex[ 2 ] = values[ offset + 2 ];
+
+    return cursor;
+}
+
+// Parse a face record and append its triangles. The cursor must be at its
+// first token and is left at the beginning of the next line.
+static const char* parseFace( const char* cursor, const char* end, int nv,
+                              std::vector< int >& face, std::vector< CornerType >& indices )
+{
+    int nIndices = 0;
+    cursor = parseInteger( cursor, end, nIndices );
+
+    face.clear();
+
+    // Integer tokens up to the end of the line or up to a float color
+    while( cursor && !isLineEnd( cursor = skipInLine( cursor, end ), end ) )
+    {
+        int index;
+        const char* next = parseInteger( cursor, end, index );
+
+        if( !next )
+            break;
+
+        face.push_back( index );
+        cursor = next;
+    }
+
+    if( !cursor )
+        return nullptr;
+
+    // Some files store the face index instead of the number of vertices.
+    // In this case the line holds exactly three vertex indices.
+    if( nIndices < 3 || ( size_t )nIndices > face.size() )
+    {
+        if( face.size() != 3 )
+            return nullptr;
+
+        nIndices = 3;
+    }
+
+    for( int i = 0; i < nIndices; i++ )
+    {
+        if( face[ i ] < 0 || face[ i ] >= nv )
+            return nullptr;
+    }
+
+    // Fan triangulation
+    for( int i = 2; i < nIndices; i++ )
+    {
+        indices.push_back( face[ 0 ] );
+        indices.push_back( face[ i - 1 ] );
+        indices.push_back( face[ i ] );
+    }
+
+    // Skip optional face colors
+    return skipLine( cursor, end );
+}
+
+// Number of lines holding at least one token. These are the lines that the
+// serial parser takes as vertex or face records.
+static int countRecords( const char* cursor, const char* end )
+{
+    int nRecords = 0;
+
+    while( cursor < end )
+    {
+        if( !isLineEnd( skipInLine( cursor, end ), end ) )
+            nRecords++;
+
+        cursor = skipLine( cursor, end );
+    }
+
+    return nRecords;
+}
+
+static void printInvalidRecord( int record, int nv, const std::string& filename )
+{
+    if( record < nv )
+        cout << "Invalid vertex " << record << " in " << filename << endl;
+    else
+        cout << "Invalid face " << record - nv << " in " << filename << endl;
+}
+
+void OFFMeshLoader::setParseMode( ParseMode mode )
+{
+    _parseMode = mode;
+}
+
+void OFFMeshLoader::setNumberThreads( unsigned int numberThreads )
+{
+    _numberThreads = numberThreads;
+}
+
+void OFFMeshLoader::setCacheEnabled( bool isCacheEnabled )
+{
+    _isCacheEnabled = isCacheEnabled;
+}
+
+bool OFFMeshLoader::parseSerial( const char* cursor, const char* end, int nv, int nf, const std::string& filename,
+                                 std::vector< double >& vertices, std::vector< CornerType >& indices )
+{
+    std::vector< int > face;
+    indices.reserve( 3 * ( size_t )nf );
+
+    for( int record = 0; record < nv + nf; record++ )
+    {
+        cursor = skipToToken( cursor, end );
+
+        if( record < nv )
+            cursor = parseVertex( cursor, end, &vertices[ 3 * record ] );
+        else
+            cursor = parseFace( cursor, end, nv, face, indices );
+
+        if( !cursor )
         {
-            delimiterPos_0 = delimiterPos_1;
-            delimiterPos_1 = readLine.find(" ", delimiterPos_1 + 1 );
+            printInvalidRecord( record, nv, filename );
+            return false;
         }
-        
-        vertexes[index++] = ( stod(readLine.substr(delimiterPos_0, delimiterPos_1).c_str()) );
-        //vertexes.push_back( atof(readLine.substr(0, delimiterPos_1).c_str()) );
-        //vertexes.push_back( strtod( buffer, &buffer ) );
-        delimiterPos_2 = readLine.find(" ", delimiterPos_1 + 1);
-        vertexes[index++] = ( stod(readLine.substr(delimiterPos_1, delimiterPos_2).c_str()) );
-        //vertexes.push_back( atof(readLine.substr(delimiterPos_1, delimiterPos_2).c_str()));
-        //vertexes.push_back( strtod( buffer, &buffer ) );
-        delimiterPos_3 = readLine.find(" ", delimiterPos_2 + 1);
-        vertexes[index++] = ( stod(readLine.substr(delimiterPos_2, delimiterPos_3).c_str()) );
-        //vertexes.push_back( atof(readLine.substr(delimiterPos_2, delimiterPos_3).c_str()) );
-        //vertexes.push_back( strtod( buffer, &buffer ) );
-
-        /*cout << vertexes[n] << "\t" << vertexes[n+1] << "\t" <<
-                vertexes[n+2] << "\t" << endl;*/
-    }
-
-    // Read the facades
-    std::vector< int > indices;
-    indices.reserve(nf*3);
-    
-    for (int n = 0; n < nf; n++) {
-        getline(in, readLine);
-        delimiterPos_1 = readLine.find(" ", 0);
-        //delimiterPos_2 = readLine.find(" ", delimiterPos_1 + 1);
-        delimiterPos_2 = readLine.find(" ", 0);
-//        indices.push_back(
-//                atoi(readLine.substr(delimiterPos_1, delimiterPos_2).c_str()));
-        delimiterPos_3 = readLine.find(" ", delimiterPos_2 + 1);
-        indices.push_back(
-                atoi(readLine.substr(delimiterPos_2, delimiterPos_3).c_str()));
-        delimiterPos_4 = readLine.find(" ", delimiterPos_3 + 1);
-        indices.push_back(
-                atoi(readLine.substr(delimiterPos_3, delimiterPos_4).c_str()));
-        delimiterPos_5 = readLine.find(" ", delimiterPos_4 + 1);
-        indices.push_back(
-                atoi(readLine.substr(delimiterPos_4, delimiterPos_5).c_str()));
-
-        /*cout << indices[n] << "\t" << indices[n+1] << "\t" <<
-                indices[n+2] << "\t" << endl;*/
-    }    
-    
-    return std::make_shared< CornerTable >( &indices[ 0 ], &vertexes[ 0 ], nf, nv, 3 );
+    }
+
+    return true;
 }
 
+bool OFFMeshLoader::parseParallel( const char* cursor, const char* end, int nv, int nf, const std::string& filename,
+                                   std::vector< double >& vertices, std::vector< CornerType >& indices )
+{
+    int nThreads = _numberThreads;
+
+#ifdef _OPENMP
+    if( !nThreads )
+        nThreads = omp_get_max_threads();
+#endif
+
+    size_t size = end - cursor;
+    size_t nChunks = std::min( std::max( size / MIN_CHUNK_SIZE, ( size_t )1 ), ( size_t )( 8 * std::max( nThreads, 1 ) ) );
+
+    if( nThreads <= 1 || nChunks < 2 )
+        return parseSerial( cursor, end, nv, nf, filename, vertices, indices );
+
+    // Chunk boundaries are moved to the beginning of a line, so that every
+    // record belongs to exactly one chunk
+    std::vector< const char* > chunkBegin( nChunks + 1 );
+    chunkBegin[ 0 ] = cursor;
+    chunkBegin[ nChunks ] = end;
+
+    for( size_t i = 1; i < nChunks; i++ )
+    {
+        const char* boundary = skipLine( cursor + i * size / nChunks - 1, end );
+        chunkBegin[ i ] = std::max( boundary, chunkBegin[ i - 1 ] );
+    }
+
+    // First pass: number of records of each chunk
+    std::vector< int > firstRecord( nChunks + 1, 0 );
+
+    #pragma omp parallel for num_threads( nThreads ) schedule( dynamic )
+    for( size_t i = 0; i < nChunks; i++ )
+    {
+        firstRecord[ i + 1 ] = countRecords( chunkBegin[ i ], chunkBegin[ i + 1 ] );
+    }
+
+    for( size_t i = 0; i < nChunks; i++ )
+    {
+        firstRecord[ i + 1 ] += firstRecord[ i ];
+    }
+
+    // Second pass: vertices go straight to their position, triangles to the
+    // list of the chunk
+    int nRecords = nv + nf;
+    std::vector< int > invalidRecord( nChunks, nRecords );
+    std::vector< std::vector< CornerType > > chunkIndices( nChunks );
+
+    #pragma omp parallel for num_threads( nThreads ) schedule( dynamic )
+    for( size_t i = 0; i < nChunks; i++ )
+    {
+        const char* chunkCursor = chunkBegin[ i ];
+        std::vector< int > face;
+
+        for( int record = firstRecord[ i ]; record < std::min( firstRecord[ i + 1 ], nRecords ); record++ )
+        {
+            chunkCursor = skipToToken( chunkCursor, chunkBegin[ i + 1 ] );
+
+            if( record < nv )
+                chunkCursor = parseVertex( chunkCursor, chunkBegin[ i + 1 ], &vertices[ 3 * record ] );
+            else
+                chunkCursor = parseFace( chunkCursor, chunkBegin[ i + 1 ], nv, face, chunkIndices[ i ] );
+
+            if( !chunkCursor )
+            {
+                invalidRecord[ i ] = record;
+                break;
+            }
+        }
+    }
+
+    // Report the same record as the serial parser would
+    int firstInvalid = std::min( *std::min_element( invalidRecord.begin(), invalidRecord.end() ), firstRecord[ nChunks ] );
+
+    if( firstInvalid < nRecords )
+    {
+        printInvalidRecord( firstInvalid, nv, filename );
+        return false;
+    }
+
+    // Stitch the triangles in chunk order
+    std::vector< size_t > chunkOffset( nChunks + 1, 0 );
+
+    for( size_t i = 0; i < nChunks; i++ )
+    {
+        chunkOffset[ i + 1 ] = chunkOffset[ i ] + chunkIndices[ i ].size();
+    }
+
+    indices.resize( chunkOffset[ nChunks ] );
+
+    #pragma omp parallel for num_threads( nThreads ) schedule( dynamic )
+    for( size_t i = 0; i < nChunks; i++ )
+    {
+        std::copy( chunkIndices[ i ].begin(), chunkIndices[ i ].end(), indices.begin() + chunkOffset[ i ] );
+    }
+
+    return true;
+}
+
+// Warn about the edges that were left as borders because they are not manifold
+static void printNonManifoldCorners( const std::string& filename, const CornerTable& cornerTable )
+{
+    size_t nCorners = cornerTable.getNonManifoldCorners().size();
+
+    if( nCorners )
+        cout << "Found " << nCorners << " corners on non-manifold edges in " << filename << endl;
+}
+
+std::shared_ptr< CornerTable > OFFMeshLoader::parse( string filename )
+{
+    // strtod is only used as fallback, but it must not depend on the user locale
+    setlocale( LC_ALL, "C" );
+
+    // Reload from the sidecar cache if it was built from this very file
+    MeshCache cache;
+    MeshCache::SourceStamp stamp;
+    std::string cacheFilename = MeshCache::getCacheFilename( filename );
+    bool isCacheable = _isCacheEnabled && MeshCache::getSourceStamp( filename, stamp );
+
+    if( isCacheable )
+    {
+        std::shared_ptr< CornerTable > cachedCornerTable = cache.read( cacheFilename, stamp );
+
+        if( cachedCornerTable )
+        {
+            printNonManifoldCorners( filename, *cachedCornerTable );
+            return cachedCornerTable;
+        }
+    }
+
+    MappedFile file( filename );
+
+    if( !file.isOpen() )
+    {
+        cout << "Could not open the file " << filename << endl;
+        return nullptr;
+    }
+
+    const char* cursor = file.getData();
+    const char* end = cursor + file.getSize();
+
+    // Check if file is in OFF format
+    cursor = skipToToken( cursor, end );
+
+    if( end - cursor < 3 || strncmp( cursor, "OFF", 3 ) != 0 || !isTokenEnd( cursor + 3, end ) )
+    {
+        cout << "The file to read is not in OFF format." << endl;
+        return nullptr;
+    }
+
+    cursor += 3;
+
+    // Read values for Nv and Nf. The number of edges is ignored.
+    int nv = -1, nf = -1;
+
+    cursor = skipToToken( cursor, end );
+    cursor = parseInteger( cursor, end, nv );
+
+    if( cursor )
+    {
+        cursor = skipToToken( cursor, end );
+        cursor = parseInteger( cursor, end, nf );
+    }
+
+    if( !cursor || nv < 0 || nf < 0 )
+    {
+        cout << "Invalid OFF header in " << filename << endl;
+        return nullptr;
+    }
+
+    cursor = skipLine( cursor, end );
+
+    // Vertices and faces, written directly in the vectors of the CornerTable
+    std::vector< double > vertices( 3 * ( size_t )nv );
+    std::vector< CornerType > indices;
+
+    bool isValid = ( _parseMode == PARALLEL ) ?
+        parseParallel( cursor, end, nv, nf, filename, vertices, indices ) :
+        parseSerial( cursor, end, nv, nf, filename, vertices, indices );
+
+    if( !isValid )
+        return nullptr;
+
+    std::shared_ptr< CornerTable > cornerTable =
+        std::make_shared< CornerTable >( std::move( indices ), std::move( vertices ), 3 );
+
+    printNonManifoldCorners( filename, *cornerTable );
+
+    // A failure here only means that the next load parses the file again
+    if( isCacheable )
+        cache.write( cacheFilename, *cornerTable, stamp );
+
+    return cornerTable;
+}
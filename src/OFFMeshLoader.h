@@ -1,4 +1,4 @@
-/* 
+/*
  * File:   OFFMeshLoader.h
  * Author: allan
  *
@@ -11,21 +11,76 @@
 #include "CornerTable.h"
 #include <string>
 #include <memory>
+#include <vector>
 
-class OFFMeshLoader 
-{    
+class OFFMeshLoader
+{
 public:
-    
+
+    enum ParseMode
+    {
+        SERIAL = 0,
+        PARALLEL
+    };
+
     OFFMeshLoader();
-    
+
     virtual ~OFFMeshLoader() {};
-        
+
+    /**
+     * Load an OFF file. The file is memory mapped and scanned once, writing
+     * the coordinates and indices straight into the vectors handed to the
+     * CornerTable. Comments (#), blank lines and any amount of whitespace are
+     * accepted between tokens. Vertex lines with more than three values are
+     * assumed to start with the vertex index. Face lines that store the face
+     * index in place of the number of vertices are read as triangles, and
+     * polygonal faces are fan triangulated. The adjacency is reloaded from the
+     * binary cache when it is available.
+     * @param filename - path of the OFF file.
+     * @return - the loaded mesh or nullptr if the file is invalid.
+     */
     std::shared_ptr< CornerTable > parse( std::string filename );
-    
+
+    /**
+     * Choose between the serial and the parallel parser. The parallel parser
+     * splits the vertex and face sections into line aligned chunks, parses
+     * them concurrently and stitches the triangles back in file order, so its
+     * result is identical to the serial one. Small files are always parsed
+     * serially. The default mode is PARALLEL.
+     * @param mode - parse mode.
+     */
+    void setParseMode( ParseMode mode );
+
+    /**
+     * Define the number of threads used by the parallel parser.
+     * @param numberThreads - number of threads. Zero uses all the available
+     * cores.
+     */
+    void setNumberThreads( unsigned int numberThreads );
+
+    /**
+     * Enable the binary sidecar cache (see MeshCache). When enabled, parse
+     * reloads the mesh from "<filename>.mcc" if the cache matches the size and
+     * modification time of the file, and writes the cache next to the file
+     * otherwise. It is disabled by default, so that loading a mesh does not
+     * write next to the user data.
+     * @param isCacheEnabled - true to use the cache.
+     */
+    void setCacheEnabled( bool isCacheEnabled );
+
 private:
-    
-    std::string _currentPath;
 
+    bool parseSerial( const char* cursor, const char* end, int nv, int nf, const std::string& filename,
+                      std::vector< double >& vertices, std::vector< CornerType >& indices );
+
+    bool parseParallel( const char* cursor, const char* end, int nv, int nf, const std::string& filename,
+                        std::vector< double >& vertices, std::vector< CornerType >& indices );
+
+    ParseMode _parseMode;
+
+    unsigned int _numberThreads;
+
+    bool _isCacheEnabled;
 };
 
 #endif /* MESHLOADER_H */
@@ -0,0 +1,67 @@
+/*
+ * File:   OFFMeshWriter.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "OFFMeshWriter.h"
+
+#include <fstream>
+#include <cstdio>
+
+//Size of the text written to the file at a time.
+static const size_t CHUNK_SIZE = 1 << 20;
+
+bool OFFMeshWriter::write( const std::string& filename, const CornerTable& cornerTable )
+{
+    std::string temporaryFilename = filename + ".tmp";
+    std::ofstream out( temporaryFilename.c_str(), std::ios::binary | std::ios::trunc );
+
+    if( !out )
+        return false;
+
+    // Lines are formatted into a buffer, flushed once it holds a chunk
+    std::string text;
+    text.reserve( CHUNK_SIZE + 256 );
+    char line[ 256 ];
+
+    auto append = [ & ]( int length )
+    {
+        text.append( line, length );
+
+        if( text.size() >= CHUNK_SIZE )
+        {
+            out.write( text.data(), text.size() );
+            text.clear();
+        }
+    };
+
+    CornerType numberVertices = cornerTable.getNumberVertices();
+    CornerType numberTriangles = cornerTable.getNumTriangles();
+    const CornerType* triangleList = cornerTable.getTriangleList();
+
+    append( snprintf( line, sizeof( line ), "OFF\n%d %d 0\n", numberVertices, numberTriangles ) );
+
+    for( CornerType vertex = 0; vertex < numberVertices; vertex++ )
+    {
+        append( snprintf( line, sizeof( line ), "%.17g %.17g %.17g\n", cornerTable.getCoordinate( vertex, 0 ),
+                          cornerTable.getCoordinate( vertex, 1 ), cornerTable.getCoordinate( vertex, 2 ) ) );
+    }
+
+    for( CornerType triangle = 0; triangle < numberTriangles; triangle++ )
+    {
+        append( snprintf( line, sizeof( line ), "3 %d %d %d\n", triangleList[ 3 * triangle ],
+                          triangleList[ 3 * triangle + 1 ], triangleList[ 3 * triangle + 2 ] ) );
+    }
+
+    out.write( text.data(), text.size() );
+    out.close();
+
+    if( !out )
+    {
+        std::remove( temporaryFilename.c_str() );
+        return false;
+    }
+
+    return std::rename( temporaryFilename.c_str(), filename.c_str() ) == 0;
+}
@@ -0,0 +1,34 @@
+/*
+ * File:   OFFMeshWriter.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef OFFMESHWRITER_H
+#define OFFMESHWRITER_H
+
+#include "CornerTable.h"
+#include <string>
+
+class OFFMeshWriter
+{
+public:
+
+    OFFMeshWriter() {};
+
+    virtual ~OFFMeshWriter() {};
+
+    /**
+     * Write a mesh as an OFF file, that OFFMeshLoader reads back. The
+     * coordinates are written with 17 significant digits, so they are read
+     * back exactly. The file is written on a temporary name and renamed, so a
+     * partially written mesh is never left behind.
+     * @param filename - path of the OFF file.
+     * @param cornerTable - mesh to be written. Only the first three attributes
+     * of each vertex are written.
+     * @return - true if the file was written.
+     */
+    bool write( const std::string& filename, const CornerTable& cornerTable );
+};
+
+#endif /* OFFMESHWRITER_H */
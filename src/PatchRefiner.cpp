@@ -0,0 +1,421 @@
+/*
+ * File:   PatchRefiner.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "PatchRefiner.h"
+
+#include "SparseMatrix.h"
+#include "Trace.h"
+
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+using namespace std;
+
+//Ratio between the edges of a refined triangle and the scale of its vertices.
+static const double DENSITY_CONTROL = M_SQRT2;
+
+//Maximum number of flips of a relaxation, by edge of the patch.
+static const unsigned int FLIPS_BY_EDGE = 8;
+
+//Relative residual and maximum number of iterations of the fairing solver.
+static const double FAIRING_TOLERANCE = 1e-8;
+static const size_t MAXIMUM_ITERATIONS = 20000;
+
+//Minimum number of triangles to select the triangles to split in parallel.
+static CornerType parallelThreshold = 4096;
+
+PatchRefiner::PatchRefiner( std::shared_ptr< CornerTable > patch, CornerType numberBoundaryVertices ) :
+    _patch( patch ),
+    _numberBoundaryVertices( numberBoundaryVertices )
+{
+}
+
+PatchRefiner::~PatchRefiner()
+{
+}
+
+void PatchRefiner::refine( const std::vector< double >& boundaryScales )
+{
+    TRACE_SCOPE_ARGUMENT( "refine", "triangles", _patch->getNumTriangles() );
+
+    _scales = boundaryScales;
+    _statistics.clear();
+
+    bool isRelaxed = false;
+
+    while( true )
+    {
+        RoundStatistics round;
+        CornerType numberTriangles = _patch->getNumTriangles();
+        TRACE_SCOPE_ARGUMENT( "refinement round", "triangles", numberTriangles );
+
+        // The triangles to split are chosen before any split, so the result
+        // does not depend on the number of threads
+        selectTriangles();
+        round.splits = _splitTriangles.size();
+
+        if( round.splits == 0 )
+            break;
+
+        _patch->reserve( numberTriangles + 2 * round.splits, _patch->getNumberVertices() + round.splits );
+        _scales.reserve( _patch->getNumberVertices() + round.splits );
+
+        {
+            TRACE_SCOPE_ARGUMENT( "split triangles", "splits", round.splits );
+
+            for( CornerType triangle : _splitTriangles )
+                splitTriangle( triangle );
+        }
+
+        // The edges of the first triangulation are relaxed with the first
+        // split ones, then only the edges of the triangles changed since
+        if( !isRelaxed )
+        {
+            isRelaxed = true;
+
+            for( CornerType corner = 0; corner < 3 * _patch->getNumTriangles(); corner++ )
+                pushEdge( corner );
+        }
+        else
+        {
+            for( CornerType triangle : _splitTriangles )
+                for( CornerType corner = 3 * triangle; corner < 3 * triangle + 3; corner++ )
+                    pushEdge( corner );
+
+            for( CornerType corner = 3 * numberTriangles; corner < 3 * _patch->getNumTriangles(); corner++ )
+                pushEdge( corner );
+        }
+
+        relaxEdges( round );
+        round.bytes += _scales.capacity() * sizeof( double ) + _splitTriangles.capacity() * sizeof( CornerType ) +
+                       _isSelected.capacity() + _isQueued.capacity() / 8;
+        _statistics.push_back( round );
+    }
+}
+
+void PatchRefiner::fair( FairingMode mode )
+{
+    TRACE_SCOPE_ARGUMENT( "fair", "vertices", _patch->getNumberVertices() );
+
+    auto start = chrono::steady_clock::now();
+    _fairingStatistics = FairingStatistics();
+
+    CornerType numberVertices = _patch->getNumberVertices();
+
+    if( numberVertices <= _numberBoundaryVertices )
+        return;
+
+    // K = D - W over all the vertices of the patch, W with the weight of
+    // each edge and D with their sums by vertex. Each corner adds its share
+    // of the weight of the edge in front of it.
+    vector< SparseMatrix::Entry > entries;
+    entries.reserve( 12 * ( size_t )_patch->getNumTriangles() );
+
+    for( CornerType corner = 0; corner < 3 * _patch->getNumTriangles(); corner++ )
+    {
+        CornerType vc = _patch->cornerToVertexIndex( corner );
+        CornerType va = _patch->cornerToVertexIndex( _patch->cornerNext( corner ) );
+        CornerType vb = _patch->cornerToVertexIndex( _patch->cornerPrevious( corner ) );
+
+        double pa[ 3 ], pb[ 3 ], pc[ 3 ];
+
+        for( unsigned int k = 0; k < 3; k++ )
+        {
+            pa[ k ] = _patch->getCoordinate( va, k );
+            pb[ k ] = _patch->getCoordinate( vb, k );
+            pc[ k ] = _patch->getCoordinate( vc, k );
+        }
+
+        double weight = 0.;
+
+        if( mode == HARMONIC )
+        {
+            // Half of the cotangent of the angle of the corner, clamped at
+            // zero so that K stays positive definite
+            double u[ 3 ] = { pa[ 0 ] - pc[ 0 ], pa[ 1 ] - pc[ 1 ], pa[ 2 ] - pc[ 2 ] };
+            double v[ 3 ] = { pb[ 0 ] - pc[ 0 ], pb[ 1 ] - pc[ 1 ], pb[ 2 ] - pc[ 2 ] };
+            double cross[ 3 ] = { u[ 1 ] * v[ 2 ] - u[ 2 ] * v[ 1 ],
+                                  u[ 2 ] * v[ 0 ] - u[ 0 ] * v[ 2 ],
+                                  u[ 0 ] * v[ 1 ] - u[ 1 ] * v[ 0 ] };
+            double sine = sqrt( cross[ 0 ] * cross[ 0 ] + cross[ 1 ] * cross[ 1 ] + cross[ 2 ] * cross[ 2 ] );
+
+            if( sine > 0. )
+                weight = max( 0., 0.5 * ( u[ 0 ] * v[ 0 ] + u[ 1 ] * v[ 1 ] + u[ 2 ] * v[ 2 ] ) / sine );
+        }
+        else
+        {
+            // Inverse of the length, split between the two sides of the edge
+            double length = sqrt( ( pa[ 0 ] - pb[ 0 ] ) * ( pa[ 0 ] - pb[ 0 ] ) +
+                                  ( pa[ 1 ] - pb[ 1 ] ) * ( pa[ 1 ] - pb[ 1 ] ) +
+                                  ( pa[ 2 ] - pb[ 2 ] ) * ( pa[ 2 ] - pb[ 2 ] ) );
+
+            if( length > 0. )
+                weight = ( _patch->cornerOpposite( corner ) == CornerTable::BORDER_CORNER ? 1. : 0.5 ) / length;
+        }
+
+        entries.push_back( SparseMatrix::Entry( va, vb, -weight ) );
+        entries.push_back( SparseMatrix::Entry( vb, va, -weight ) );
+        entries.push_back( SparseMatrix::Entry( va, va, weight ) );
+        entries.push_back( SparseMatrix::Entry( vb, vb, weight ) );
+    }
+
+    _fairingStatistics.bytes = entries.capacity() * sizeof( SparseMatrix::Entry );
+
+    SparseMatrix laplacian( numberVertices, std::move( entries ) );
+    _fairingStatistics.bytes += laplacian.getAllocatedBytes();
+
+    TRACE_SCOPE( "solve fairing" );
+    solveFairing( laplacian, mode == SECOND_ORDER );
+
+    _fairingStatistics.milliseconds = chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+void PatchRefiner::solveFairing( const SparseMatrix& laplacian, bool isSecondOrder )
+{
+    // The unknowns are the vertices inside of the patch. The system is
+    // K x = 0 on them, or K K x = 0 for the second order, with the boundary
+    // vertices as constraints moved to the right hand side.
+    CornerType numberVertices = _patch->getNumberVertices();
+    size_t numberInterior = numberVertices - _numberBoundaryVertices;
+    vector< double > full( numberVertices ), product( numberVertices ), secondProduct( numberVertices );
+
+    auto apply = [ & ]( const vector< double >& values )
+    {
+        laplacian.multiply( values.data(), product.data() );
+
+        if( isSecondOrder )
+        {
+            laplacian.multiply( product.data(), secondProduct.data() );
+            product.swap( secondProduct );
+        }
+    };
+
+    SparseMatrix::Product interiorProduct = [ & ]( const double* x, double* y )
+    {
+        fill( full.begin(), full.begin() + _numberBoundaryVertices, 0. );
+        copy( x, x + numberInterior, full.begin() + _numberBoundaryVertices );
+        apply( full );
+        copy( product.begin() + _numberBoundaryVertices, product.end(), y );
+    };
+
+    vector< double > diagonal;
+
+    if( isSecondOrder )
+        laplacian.getRowSquares( diagonal );
+    else
+        laplacian.getDiagonal( diagonal );
+
+    diagonal.erase( diagonal.begin(), diagonal.begin() + _numberBoundaryVertices );
+
+    vector< double > b( numberInterior ), x( numberInterior );
+    _fairingStatistics.residual = 0.;
+    _fairingStatistics.bytes += ( full.capacity() + product.capacity() + secondProduct.capacity() +
+                                  diagonal.capacity() + b.capacity() + x.capacity() ) * sizeof( double );
+    size_t solverBytes = 0;
+
+    for( unsigned int k = 0; k < 3; k++ )
+    {
+        for( CornerType vertex = 0; vertex < numberVertices; vertex++ )
+            full[ vertex ] = ( vertex < _numberBoundaryVertices ) ? _patch->getCoordinate( vertex, k ) : 0.;
+
+        apply( full );
+
+        for( size_t i = 0; i < numberInterior; i++ )
+        {
+            b[ i ] = -product[ _numberBoundaryVertices + i ];
+            x[ i ] = _patch->getCoordinate( _numberBoundaryVertices + i, k );
+        }
+
+        TRACE_SCOPE_ARGUMENT( "conjugate gradient", "coordinate", k );
+
+        SparseMatrix::SolverStatistics solve = SparseMatrix::solveConjugateGradient( interiorProduct, diagonal, b, x,
+                                                                                     FAIRING_TOLERANCE,
+                                                                                     MAXIMUM_ITERATIONS );
+
+        _fairingStatistics.iterations += solve.iterations;
+        _fairingStatistics.residual = max( _fairingStatistics.residual, solve.residual );
+        solverBytes = max( solverBytes, solve.bytes );
+
+        for( size_t i = 0; i < numberInterior; i++ )
+            _patch->setCoordinate( _numberBoundaryVertices + i, k, x[ i ] );
+    }
+
+    _fairingStatistics.bytes += solverBytes;
+}
+
+const PatchRefiner::FairingStatistics& PatchRefiner::getFairingStatistics() const
+{
+    return _fairingStatistics;
+}
+
+bool PatchRefiner::relaxEdge( CornerType corner )
+{
+    CornerType opposite = _patch->cornerOpposite( corner );
+
+    if( opposite == CornerTable::BORDER_CORNER || !_patch->areEdgeTrianglesInCircumsphere( corner ) )
+        return false;
+
+    // The new edge must not exist yet, or the flip would fold the patch
+    CornerType a = _patch->cornerToVertexIndex( corner );
+    CornerType b = _patch->cornerToVertexIndex( opposite );
+
+    if( a == b || hasEdge( a, b ) )
+        return false;
+
+    return _patch->edgeFlip( corner );
+}
+
+const std::vector< PatchRefiner::RoundStatistics >& PatchRefiner::getStatistics() const
+{
+    return _statistics;
+}
+
+void PatchRefiner::relaxEdges( RoundStatistics& round )
+{
+    TRACE_SCOPE_ARGUMENT( "relax edges", "queued", _relaxQueue.size() );
+
+    // A flip in 3D may undo a previous one, so the flips are bounded
+    size_t maximumFlips = ( size_t )FLIPS_BY_EDGE * 3 * _patch->getNumTriangles() / 2;
+    size_t maximumQueued = 0;
+
+    while( !_relaxQueue.empty() )
+    {
+        maximumQueued = max( maximumQueued, _relaxQueue.size() );
+        CornerType corner = _relaxQueue.front();
+        _relaxQueue.pop_front();
+        _isQueued[ corner ] = false;
+
+        if( round.flips >= maximumFlips )
+        {
+            round.isComplete = false;
+            continue;
+        }
+
+        round.checks++;
+
+        CornerType opposite = _patch->cornerOpposite( corner );
+
+        if( !relaxEdge( corner ) )
+            continue;
+
+        round.flips++;
+
+        // The four edges around the new one have a new opposite vertex
+        pushEdge( corner );
+        pushEdge( _patch->cornerPrevious( corner ) );
+        pushEdge( opposite );
+        pushEdge( _patch->cornerPrevious( opposite ) );
+    }
+
+    round.bytes = maximumQueued * sizeof( CornerType );
+}
+
+void PatchRefiner::pushEdge( CornerType corner )
+{
+    CornerType opposite = _patch->cornerOpposite( corner );
+
+    if( opposite == CornerTable::BORDER_CORNER )
+        return;
+
+    // Each edge once, by the smallest of its corners
+    corner = min( corner, opposite );
+
+    if( _isQueued.size() < 3 * ( size_t )_patch->getNumTriangles() )
+        _isQueued.resize( 3 * ( size_t )_patch->getNumTriangles(), false );
+
+    if( _isQueued[ corner ] )
+        return;
+
+    _isQueued[ corner ] = true;
+    _relaxQueue.push_back( corner );
+}
+
+void PatchRefiner::setParallelThreshold( const CornerType numberTriangles )
+{
+    parallelThreshold = numberTriangles;
+}
+
+void PatchRefiner::selectTriangles()
+{
+    TRACE_SCOPE( "select triangles" );
+    CornerType numberTriangles = _patch->getNumTriangles();
+    _isSelected.assign( numberTriangles, 0 );
+
+    #pragma omp parallel for schedule(static) if( numberTriangles >= parallelThreshold )
+    for( CornerType triangle = 0; triangle < numberTriangles; triangle++ )
+    {
+        double centroid[ 3 ], centroidScale;
+        _isSelected[ triangle ] = isSplit( triangle, centroid, centroidScale );
+    }
+
+    _splitTriangles.clear();
+
+    for( CornerType triangle = 0; triangle < numberTriangles; triangle++ )
+    {
+        if( _isSelected[ triangle ] )
+            _splitTriangles.push_back( triangle );
+    }
+}
+
+bool PatchRefiner::isSplit( CornerType triangle, double* centroid, double& centroidScale ) const
+{
+    CornerType vertices[ 3 ];
+    double points[ 3 ][ 3 ];
+
+    centroid[ 0 ] = centroid[ 1 ] = centroid[ 2 ] = 0.;
+    centroidScale = 0.;
+
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        vertices[ i ] = _patch->cornerToVertexIndex( 3 * triangle + i );
+        centroidScale += _scales[ vertices[ i ] ];
+
+        for( unsigned int k = 0; k < 3; k++ )
+        {
+            points[ i ][ k ] = _patch->getCoordinate( vertices[ i ], k );
+            centroid[ k ] += points[ i ][ k ];
+        }
+    }
+
+    centroidScale /= 3.;
+
+    for( unsigned int k = 0; k < 3; k++ )
+        centroid[ k ] /= 3.;
+
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        double length = DENSITY_CONTROL * sqrt( ( centroid[ 0 ] - points[ i ][ 0 ] ) * ( centroid[ 0 ] - points[ i ][ 0 ] ) +
+                                                ( centroid[ 1 ] - points[ i ][ 1 ] ) * ( centroid[ 1 ] - points[ i ][ 1 ] ) +
+                                                ( centroid[ 2 ] - points[ i ][ 2 ] ) * ( centroid[ 2 ] - points[ i ][ 2 ] ) );
+
+        if( length <= centroidScale || length <= _scales[ vertices[ i ] ] )
+            return false;
+    }
+
+    return true;
+}
+
+void PatchRefiner::splitTriangle( CornerType triangle )
+{
+    double centroid[ 3 ], centroidScale;
+    isSplit( triangle, centroid, centroidScale );
+
+    _scales.push_back( centroidScale );
+    _patch->triangleSplit( triangle, centroid );
+}
+
+bool PatchRefiner::hasEdge( CornerType a, CornerType b ) const
+{
+    for( CornerType neighbour : _patch->getCornerStar( _patch->vertexToCornerIndex( a ) ) )
+    {
+        if( _patch->cornerToVertexIndex( neighbour ) == b )
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,216 @@
+/*
+ * File:   PatchRefiner.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef PATCHREFINER_H
+#define PATCHREFINER_H
+
+#include "CornerTable.h"
+#include "SparseMatrix.h"
+#include <vector>
+#include <deque>
+#include <memory>
+
+/**@class PatchRefiner
+ * Refinement and fairing of the patch that fills a hole (Liepa), done in
+ * place on the patch CornerTable. The triangles are split at their centroids
+ * until their edges match the scale of the mesh around the hole, and the
+ * edges are flipped to be locally Delaunay after each pass. A pass first
+ * selects the triangles to split, by several threads on large patches, then
+ * splits them all in order, so its result is the same with any number of
+ * threads. The relaxation
+ * is driven by a queue of suspect edges: the edges of the triangles changed
+ * by the pass, then the four edges around each flip. The fairing solves
+ * for the vertices inside of the patch that make it as smooth as the chosen
+ * operator allows, in one sparse solve by coordinate.
+ *
+ * The first vertices of the patch are the vertices of the hole, in the order
+ * of the boundary, and they are never moved.
+ */
+class PatchRefiner
+{
+public:
+
+    enum FairingMode
+    {
+        SCALAR = 0,
+        HARMONIC,
+        SECOND_ORDER
+    };
+
+    /**
+     * Work done by a pass of the refinement.
+     */
+    struct RoundStatistics
+    {
+        RoundStatistics() : splits( 0 ), checks( 0 ), flips( 0 ), bytes( 0 ), isComplete( true ) { };
+
+        size_t splits, checks, flips;
+
+        /**
+         * Bytes held by the work arrays of the refiner at the end of the
+         * pass, with the queue of edges at its longest.
+         */
+        size_t bytes;
+
+        /**
+         * False if the relaxation stopped on its maximum number of flips.
+         */
+        bool isComplete;
+    };
+
+    /**
+     * Create a refiner for the patch of a hole.
+     * @param patch - patch mesh, changed in place.
+     * @param numberBoundaryVertices - number of vertices of the hole.
+     */
+    PatchRefiner( std::shared_ptr< CornerTable > patch, CornerType numberBoundaryVertices );
+
+    virtual ~PatchRefiner();
+
+    /**
+     * Split the triangles of the patch until they match the scale of the
+     * boundary, relaxing the edges after each pass.
+     * @param boundaryScales - average length of the mesh edges around each
+     * vertex of the hole, in the order of the boundary.
+     */
+    void refine( const std::vector< double >& boundaryScales );
+
+    /**
+     * Work done by the last fairing.
+     */
+    struct FairingStatistics
+    {
+        FairingStatistics() : iterations( 0 ), residual( 0. ), bytes( 0 ), milliseconds( 0. ) { };
+
+        /**
+         * Solver iterations, for the three coordinates.
+         */
+        size_t iterations;
+
+        /**
+         * Largest relative residual of the three coordinates.
+         */
+        double residual;
+
+        /**
+         * Bytes allocated while solving: the entries, the matrix and the
+         * vectors of the solver.
+         */
+        size_t bytes;
+
+        double milliseconds;
+    };
+
+    /**
+     * Move the vertices inside of the patch to the solution of K x = 0
+     * (SCALAR and HARMONIC) or K K x = 0 (SECOND_ORDER), K the Laplacian of
+     * the patch with the boundary vertices fixed.
+     * @param mode - weight of the edges of K: the inverse of their lengths
+     * (SCALAR and SECOND_ORDER) or the cotangents of their opposite angles
+     * (HARMONIC).
+     */
+    void fair( FairingMode mode );
+
+    /**
+     * Return the work done by the last fairing.
+     * @return - solver iterations, residual and time.
+     */
+    const FairingStatistics& getFairingStatistics() const;
+
+    /**
+     * Flip the edge opposite to a corner if the triangles around it are not
+     * locally Delaunay.
+     * @param corner - corner of the patch.
+     * @return - true if the edge was flipped.
+     */
+    bool relaxEdge( CornerType corner );
+
+    /**
+     * Set the minimum number of triangles for which the triangles to split
+     * are selected by several threads. The number of threads is the OpenMP
+     * default.
+     * @param numberTriangles - minimum number of triangles.
+     */
+    static void setParallelThreshold( const CornerType numberTriangles );
+
+    /**
+     * Return the work done by each pass of the last refinement.
+     * @return - statistics of the passes that split any triangle.
+     */
+    const std::vector< RoundStatistics >& getStatistics() const;
+
+private:
+
+    /**
+     * Relax the queued edges, queueing the edges around each flip. The
+     * number of flips is bounded by FLIPS_BY_EDGE times the number of edges.
+     */
+    void relaxEdges( RoundStatistics& round );
+
+    /**
+     * Queue the edge opposite to a corner, if it is not a border edge and it
+     * is not queued yet.
+     */
+    void pushEdge( CornerType corner );
+
+    /**
+     * Solve the fairing system of a Laplacian for each coordinate, from the
+     * current positions.
+     */
+    void solveFairing( const SparseMatrix& laplacian, bool isSecondOrder );
+
+    /**
+     * Fill _splitTriangles with the triangles to split on this pass.
+     */
+    void selectTriangles();
+
+    /**
+     * Return true if the distances from the centroid of a triangle to its
+     * vertices are longer than the scale of the vertices, and compute the
+     * centroid and its scale.
+     */
+    bool isSplit( CornerType triangle, double* centroid, double& centroidScale ) const;
+
+    /**
+     * Split a triangle at its centroid.
+     */
+    void splitTriangle( CornerType triangle );
+
+    /**
+     * Return true if the vertices a and b are connected by an edge.
+     */
+    bool hasEdge( CornerType a, CornerType b ) const;
+
+    std::shared_ptr< CornerTable > _patch;
+
+    CornerType _numberBoundaryVertices;
+
+    /**
+     * Scale of each vertex of the patch: the one of the mesh on the boundary
+     * and the average of the triangle on the centroids.
+     */
+    std::vector< double > _scales;
+
+    /**
+     * Triangles split on this pass, that keep their index, and a flag by
+     * triangle set by the selection.
+     */
+    std::vector< CornerType > _splitTriangles;
+    std::vector< char > _isSelected;
+
+    /**
+     * Edges to be relaxed, each by the smallest of its corners, and a flag
+     * by corner for the ones in the queue.
+     */
+    std::deque< CornerType > _relaxQueue;
+    std::vector< bool > _isQueued;
+
+    std::vector< RoundStatistics > _statistics;
+
+    FairingStatistics _fairingStatistics;
+};
+
+#endif /* PATCHREFINER_H */
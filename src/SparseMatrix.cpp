@@ -0,0 +1,184 @@
+/*
+ * File:   SparseMatrix.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "SparseMatrix.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+//Minimum number of rows to multiply in parallel.
+static const size_t PARALLEL_ROWS = 8192;
+
+SparseMatrix::SparseMatrix() :
+    _numberRows( 0 ),
+    _rowOffsets( 1, 0 )
+{
+}
+
+SparseMatrix::SparseMatrix( size_t numberRows, std::vector< Entry > entries ) :
+    _numberRows( numberRows ),
+    _rowOffsets( numberRows + 1, 0 )
+{
+    sort( entries.begin(), entries.end(), []( const Entry& a, const Entry& b )
+    {
+        return a.row < b.row || ( a.row == b.row && a.column < b.column );
+    } );
+
+    _columns.reserve( entries.size() );
+    _values.reserve( entries.size() );
+
+    for( size_t i = 0; i < entries.size(); i++ )
+    {
+        // Repeated entries are added
+        if( i > 0 && entries[ i ].row == entries[ i - 1 ].row && entries[ i ].column == entries[ i - 1 ].column )
+        {
+            _values.back() += entries[ i ].value;
+            continue;
+        }
+
+        _columns.push_back( entries[ i ].column );
+        _values.push_back( entries[ i ].value );
+        _rowOffsets[ entries[ i ].row + 1 ]++;
+    }
+
+    for( size_t row = 0; row < numberRows; row++ )
+        _rowOffsets[ row + 1 ] += _rowOffsets[ row ];
+}
+
+SparseMatrix::~SparseMatrix()
+{
+}
+
+size_t SparseMatrix::getNumberRows() const
+{
+    return _numberRows;
+}
+
+size_t SparseMatrix::getNumberEntries() const
+{
+    return _values.size();
+}
+
+size_t SparseMatrix::getAllocatedBytes() const
+{
+    return ( _rowOffsets.capacity() + _columns.capacity() ) * sizeof( size_t ) +
+           _values.capacity() * sizeof( double );
+}
+
+void SparseMatrix::multiply( const double* x, double* y ) const
+{
+    long numberRows = _numberRows;
+
+    #pragma omp parallel for schedule(static) if( _numberRows >= PARALLEL_ROWS )
+    for( long row = 0; row < numberRows; row++ )
+    {
+        double sum = 0.;
+
+        for( size_t i = _rowOffsets[ row ]; i < _rowOffsets[ row + 1 ]; i++ )
+            sum += _values[ i ] * x[ _columns[ i ] ];
+
+        y[ row ] = sum;
+    }
+}
+
+void SparseMatrix::getDiagonal( std::vector< double >& diagonal ) const
+{
+    diagonal.assign( _numberRows, 0. );
+
+    for( size_t row = 0; row < _numberRows; row++ )
+    {
+        for( size_t i = _rowOffsets[ row ]; i < _rowOffsets[ row + 1 ]; i++ )
+        {
+            if( _columns[ i ] == row )
+                diagonal[ row ] = _values[ i ];
+        }
+    }
+}
+
+void SparseMatrix::getRowSquares( std::vector< double >& squares ) const
+{
+    squares.assign( _numberRows, 0. );
+
+    for( size_t row = 0; row < _numberRows; row++ )
+    {
+        for( size_t i = _rowOffsets[ row ]; i < _rowOffsets[ row + 1 ]; i++ )
+            squares[ row ] += _values[ i ] * _values[ i ];
+    }
+}
+
+SparseMatrix::SolverStatistics SparseMatrix::solveConjugateGradient( const Product& product,
+                                                                     const std::vector< double >& diagonal,
+                                                                     const std::vector< double >& b,
+                                                                     std::vector< double >& x, double tolerance,
+                                                                     size_t maximumIterations )
+{
+    size_t n = b.size();
+    SolverStatistics statistics;
+    vector< double > r( n ), z( n ), p( n ), q( n );
+    statistics.bytes = 4 * n * sizeof( double );
+
+    auto dot = []( const vector< double >& u, const vector< double >& v )
+    {
+        double sum = 0.;
+
+        for( size_t i = 0; i < u.size(); i++ )
+            sum += u[ i ] * v[ i ];
+
+        return sum;
+    };
+
+    double normB = sqrt( dot( b, b ) );
+
+    if( normB == 0. )
+        normB = 1.;
+
+    // r = b - A x, z = M^-1 r
+    product( x.data(), q.data() );
+
+    for( size_t i = 0; i < n; i++ )
+    {
+        r[ i ] = b[ i ] - q[ i ];
+        z[ i ] = ( diagonal[ i ] != 0. ) ? r[ i ] / diagonal[ i ] : r[ i ];
+        p[ i ] = z[ i ];
+    }
+
+    double rz = dot( r, z );
+    statistics.residual = sqrt( dot( r, r ) ) / normB;
+
+    while( statistics.residual > tolerance && statistics.iterations < maximumIterations )
+    {
+        product( p.data(), q.data() );
+
+        double pq = dot( p, q );
+
+        // The matrix is not positive definite along p
+        if( pq <= 0. )
+            break;
+
+        double alpha = rz / pq;
+
+        for( size_t i = 0; i < n; i++ )
+        {
+            x[ i ] += alpha * p[ i ];
+            r[ i ] -= alpha * q[ i ];
+            z[ i ] = ( diagonal[ i ] != 0. ) ? r[ i ] / diagonal[ i ] : r[ i ];
+        }
+
+        double rzNext = dot( r, z );
+        double beta = rzNext / rz;
+        rz = rzNext;
+
+        for( size_t i = 0; i < n; i++ )
+            p[ i ] = z[ i ] + beta * p[ i ];
+
+        statistics.iterations++;
+        statistics.residual = sqrt( dot( r, r ) ) / normB;
+    }
+
+    return statistics;
+}
@@ -0,0 +1,150 @@
+/*
+ * File:   SparseMatrix.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef SPARSEMATRIX_H
+#define SPARSEMATRIX_H
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/**@class SparseMatrix
+ * Square sparse matrix in compressed sparse row (CSR) format: the columns
+ * and values of each row are contiguous and sorted by column. It is built
+ * once from a list of entries and only multiplied afterwards, so the
+ * products of large matrices are computed by several OpenMP threads.
+ *
+ * The symmetric positive definite systems are solved by a conjugate
+ * gradient preconditioned by the diagonal (Jacobi), with the matrix given
+ * by its product so that products of matrices need not be assembled.
+ */
+class SparseMatrix
+{
+public:
+
+    /**
+     * Entry of a matrix being built. Entries with the same row and column
+     * are added.
+     */
+    struct Entry
+    {
+        Entry() : row( 0 ), column( 0 ), value( 0. ) { };
+
+        Entry( size_t r, size_t c, double v ) : row( r ), column( c ), value( v ) { };
+
+        size_t row, column;
+        double value;
+    };
+
+    /**
+     * Result of a conjugate gradient solve.
+     */
+    struct SolverStatistics
+    {
+        SolverStatistics() : iterations( 0 ), residual( 0. ), bytes( 0 ) { };
+
+        /**
+         * Number of iterations.
+         */
+        size_t iterations;
+
+        /**
+         * Norm of the final residual divided by the norm of the right hand
+         * side.
+         */
+        double residual;
+
+        /**
+         * Bytes allocated for the work vectors of the solver.
+         */
+        size_t bytes;
+    };
+
+    /**
+     * Product of a matrix by a vector, y = A x.
+     */
+    typedef std::function< void ( const double* x, double* y ) > Product;
+
+    SparseMatrix();
+
+    /**
+     * Build the matrix from its entries.
+     * @param numberRows - number of rows and columns.
+     * @param entries - entries, in any order. The matrix sorts its own copy,
+     * so callers that no longer need the list should move it in.
+     */
+    SparseMatrix( size_t numberRows, std::vector< Entry > entries );
+
+    virtual ~SparseMatrix();
+
+    /**
+     * Return the number of rows and columns.
+     * @return - number of rows.
+     */
+    size_t getNumberRows() const;
+
+    /**
+     * Return the number of stored entries.
+     * @return - number of entries.
+     */
+    size_t getNumberEntries() const;
+
+    /**
+     * Return the memory held by the row offsets, columns and values.
+     * @return - number of bytes allocated.
+     */
+    size_t getAllocatedBytes() const;
+
+    /**
+     * Compute y = A x.
+     * @param x - vector with a value by column.
+     * @param y - filled with a value by row.
+     */
+    void multiply( const double* x, double* y ) const;
+
+    /**
+     * Return the entries of the diagonal.
+     * @param diagonal - filled with a value by row.
+     */
+    void getDiagonal( std::vector< double >& diagonal ) const;
+
+    /**
+     * Return the sum of the squares of the entries of each row, the
+     * diagonal of A^T A.
+     * @param squares - filled with a value by row.
+     */
+    void getRowSquares( std::vector< double >& squares ) const;
+
+    /**
+     * Solve A x = b by the Jacobi preconditioned conjugate gradient. A must
+     * be symmetric positive definite.
+     * @param product - product by A.
+     * @param diagonal - diagonal of A. Zeros are taken as ones.
+     * @param b - right hand side.
+     * @param x - initial guess, replaced by the solution.
+     * @param tolerance - relative residual to stop at.
+     * @param maximumIterations - maximum number of iterations.
+     * @return - number of iterations and relative residual.
+     */
+    static SolverStatistics solveConjugateGradient( const Product& product, const std::vector< double >& diagonal,
+                                                    const std::vector< double >& b, std::vector< double >& x,
+                                                    double tolerance, size_t maximumIterations );
+
+private:
+
+    size_t _numberRows;
+
+    /**
+     * First entry of each row, and the end of the last one.
+     */
+    std::vector< size_t > _rowOffsets;
+
+    std::vector< size_t > _columns;
+
+    std::vector< double > _values;
+};
+
+#endif /* SPARSEMATRIX_H */
@@ -0,0 +1,195 @@
+/*
+ * File:   Trace.cpp
+ *
+ * Created on October 16, 2026
+ */
+
+#include "Trace.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+
+struct Zone
+{
+    const char* name;
+    const char* argumentName;
+    int64_t argument;
+    int64_t start, stop;
+};
+
+struct ThreadBuffer
+{
+    ThreadBuffer( size_t capacity, int threadId ) :
+        zones( capacity ), next( 0 ), size( 0 ), numberDropped( 0 ), threadId( threadId ) { };
+
+    std::vector< Zone > zones;
+
+    //Position of the next zone, and number of zones kept.
+    size_t next, size;
+
+    size_t numberDropped;
+
+    int threadId;
+};
+
+//Buffers of all the threads that recorded a zone. They are kept after their
+//threads end, so their zones are still written.
+struct Registry
+{
+    Registry() : bufferSize( 1 << 16 ) { };
+
+    std::mutex mutex;
+    std::vector< std::unique_ptr< ThreadBuffer > > buffers;
+    size_t bufferSize;
+};
+
+Registry& getRegistry()
+{
+    static Registry registry;
+
+    return registry;
+}
+
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+void writeString( FILE* file, const char* text )
+{
+    fputc( '"', file );
+
+    for( ; *text; text++ )
+    {
+        if( *text == '"' || *text == '\\' )
+            fputc( '\\', file );
+
+        fputc( *text, file );
+    }
+
+    fputc( '"', file );
+}
+
+}
+
+std::atomic< bool > Trace::_isEnabled( false );
+
+void Trace::setEnabled( bool isEnabled )
+{
+    now();
+    _isEnabled.store( isEnabled, std::memory_order_relaxed );
+}
+
+void Trace::setBufferSize( size_t numberZones )
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    registry.bufferSize = ( numberZones > 0 ) ? numberZones : 1;
+}
+
+void Trace::clear()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    for( auto& buffer : registry.buffers )
+        buffer->next = buffer->size = buffer->numberDropped = 0;
+}
+
+bool Trace::writeChromeJSON( const std::string& filename )
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    FILE* file = fopen( filename.c_str(), "w" );
+
+    if( !file )
+        return false;
+
+    fprintf( file, "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n" );
+
+    bool isFirst = true;
+
+    for( auto& buffer : registry.buffers )
+    {
+        fprintf( file, "%s{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+                       "\"args\": { \"name\": \"thread %d\" } }", isFirst ? "" : ",\n",
+                 buffer->threadId, buffer->threadId );
+        isFirst = false;
+
+        size_t capacity = buffer->zones.size();
+
+        // Oldest zone first
+        for( size_t i = 0; i < buffer->size; i++ )
+        {
+            const Zone& zone = buffer->zones[ ( buffer->next + capacity - buffer->size + i ) % capacity ];
+
+            fprintf( file, ",\n{ \"name\": " );
+            writeString( file, zone.name );
+            fprintf( file, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f",
+                     buffer->threadId, 1e-3 * zone.start, 1e-3 * ( zone.stop - zone.start ) );
+
+            if( zone.argumentName )
+            {
+                fprintf( file, ", \"args\": { " );
+                writeString( file, zone.argumentName );
+                fprintf( file, ": %lld }", ( long long )zone.argument );
+            }
+
+            fprintf( file, " }" );
+        }
+    }
+
+    fprintf( file, "\n]\n}\n" );
+
+    return fclose( file ) == 0;
+}
+
+size_t Trace::getNumberDroppedZones()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    size_t numberDropped = 0;
+
+    for( auto& buffer : registry.buffers )
+        numberDropped += buffer->numberDropped;
+
+    return numberDropped;
+}
+
+int64_t Trace::now()
+{
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - origin ).count();
+}
+
+void Trace::record( const char* name, const char* argumentName, int64_t argument, int64_t start, int64_t stop )
+{
+    // The buffer of a thread is created on its first zone, the only time
+    // the registry is locked while recording
+    if( !threadBuffer )
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard< std::mutex > lock( registry.mutex );
+
+        registry.buffers.emplace_back( new ThreadBuffer( registry.bufferSize, registry.buffers.size() ) );
+        threadBuffer = registry.buffers.back().get();
+    }
+
+    ThreadBuffer& buffer = *threadBuffer;
+    size_t capacity = buffer.zones.size();
+
+    buffer.zones[ buffer.next ] = { name, argumentName, argument, start, stop };
+    buffer.next = ( buffer.next + 1 ) % capacity;
+
+    if( buffer.size < capacity )
+        buffer.size++;
+    else
+        buffer.numberDropped++;
+}
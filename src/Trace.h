@@ -0,0 +1,129 @@
+/*
+ * File:   Trace.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**@class Trace
+ * Timeline of named zones, written as a Chrome trace (chrome://tracing or
+ * Perfetto), to see where the time of a completion goes across the holes,
+ * the stages and the threads. Each thread records its zones into a ring
+ * buffer of its own, so recording takes no lock; when a buffer is full its
+ * oldest zones are dropped.
+ *
+ * The zones are compiled only with MC_TRACING defined (make TRACE=1), and
+ * otherwise TRACE_SCOPE expands to nothing. When they are compiled, nothing
+ * is recorded until setEnabled.
+ */
+class Trace
+{
+public:
+
+    /**
+     * Zone from its construction to its destruction.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Open a zone.
+         * @param name - zone name. It must outlive the trace, as a literal.
+         */
+        Scope( const char* name ) :
+            _name( name ), _argumentName( nullptr ), _argument( 0 ), _start( isEnabled() ? now() : -1 ) { };
+
+        /**
+         * Open a zone with a value shown in its details, as the size of the
+         * hole it works on.
+         * @param name - zone name. It must outlive the trace, as a literal.
+         * @param argumentName - name of the value, also a literal.
+         * @param argument - value.
+         */
+        Scope( const char* name, const char* argumentName, int64_t argument ) :
+            _name( name ), _argumentName( argumentName ), _argument( argument ),
+            _start( isEnabled() ? now() : -1 ) { };
+
+        ~Scope()
+        {
+            if( _start >= 0 )
+                record( _name, _argumentName, _argument, _start, now() );
+        };
+
+    private:
+
+        const char* _name;
+        const char* _argumentName;
+        int64_t _argument;
+        int64_t _start;
+    };
+
+    /**
+     * Start or stop recording.
+     * @param isEnabled - true to record the zones.
+     */
+    static void setEnabled( bool isEnabled );
+
+    static inline bool isEnabled()
+    {
+        return _isEnabled.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Set the number of zones kept by thread, for the buffers created after
+     * the call. The default is 65536.
+     * @param numberZones - capacity of a buffer.
+     */
+    static void setBufferSize( size_t numberZones );
+
+    /**
+     * Forget the recorded zones. No zone may be open on other threads.
+     */
+    static void clear();
+
+    /**
+     * Write the recorded zones of all the threads as a Chrome trace. No zone
+     * may be open on other threads.
+     * @param filename - path of the JSON file.
+     * @return - true if the file was written.
+     */
+    static bool writeChromeJSON( const std::string& filename );
+
+    /**
+     * Return the number of zones dropped because a buffer was full.
+     * @return - number of zones.
+     */
+    static size_t getNumberDroppedZones();
+
+private:
+
+    /**
+     * Nanoseconds since the start of the process.
+     */
+    static int64_t now();
+
+    static void record( const char* name, const char* argumentName, int64_t argument, int64_t start, int64_t stop );
+
+    static std::atomic< bool > _isEnabled;
+};
+
+#ifdef MC_TRACING
+#define TRACE_CONCATENATE_( a, b ) a##b
+#define TRACE_CONCATENATE( a, b ) TRACE_CONCATENATE_( a, b )
+#define TRACE_SCOPE( name ) Trace::Scope TRACE_CONCATENATE( traceScope, __LINE__ )( name )
+#define TRACE_SCOPE_ARGUMENT( name, argumentName, argument ) \
+    Trace::Scope TRACE_CONCATENATE( traceScope, __LINE__ )( name, argumentName, argument )
+#else
+#define TRACE_SCOPE( name )
+#define TRACE_SCOPE_ARGUMENT( name, argumentName, argument )
+#endif
+
+#endif /* TRACE_H */
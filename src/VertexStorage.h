@@ -0,0 +1,266 @@
+/*
+ * File:   VertexStorage.h
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef VERTEXSTORAGE_H
+#define VERTEXSTORAGE_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+
+/**@class InterleavedStorage
+ * Storage policy of the vertex attributes of a CornerTableT. The attributes of
+ * each vertex are contiguous: xyzxyzxyz... This is the layout of the vertex
+ * lists given to the Corner Table, so a list of the same precision is taken
+ * without copying it.
+ */
+template< typename Scalar >
+class InterleavedStorage
+{
+public:
+    typedef Scalar ScalarType;
+
+    /**
+     * The attributes of a vertex are at v * getStride( ) + coordinate.
+     */
+    static const bool IS_INTERLEAVED = true;
+
+    InterleavedStorage( ) : _numberCoordinates( 0 ) { };
+
+    /**
+     * Take an interleaved list of the same precision.
+     * @param list - attributes of all vertices.
+     * @param numberCoordinates - number of attributes by vertex.
+     */
+    void assign( std::vector< Scalar >&& list, const unsigned int numberCoordinates )
+    {
+        _data = std::move( list );
+        _numberCoordinates = numberCoordinates;
+    };
+
+    /**
+     * Copy an interleaved list of another precision.
+     * @param list - attributes of all vertices.
+     * @param numberCoordinates - number of attributes by vertex.
+     */
+    template< typename Source >
+    void assign( std::vector< Source >&& list, const unsigned int numberCoordinates )
+    {
+        assign( list.data( ), list.size( ) / numberCoordinates, numberCoordinates );
+    };
+
+    /**
+     * Copy an interleaved list.
+     * @param list - attributes of all vertices.
+     * @param numberVertices - number of vertices on the list.
+     * @param numberCoordinates - number of attributes by vertex.
+     */
+    template< typename Source >
+    void assign( const Source* list, const size_t numberVertices, const unsigned int numberCoordinates )
+    {
+        _data.assign( list, list + numberCoordinates * numberVertices );
+        _numberCoordinates = numberCoordinates;
+    };
+
+    /**
+     * Change the number of vertices that can be stored, keeping the current
+     * attributes.
+     * @param numberVertices - new capacity.
+     */
+    void resize( const size_t numberVertices )
+    {
+        _data.resize( _numberCoordinates * numberVertices );
+    };
+
+    inline Scalar get( const size_t vertex, const unsigned int coordinate ) const
+    {
+        return _data[_numberCoordinates * vertex + coordinate];
+    };
+
+    inline void set( const size_t vertex, const unsigned int coordinate, const Scalar value )
+    {
+        _data[_numberCoordinates * vertex + coordinate] = value;
+    };
+
+    /**
+     * Return the first value of a coordinate. The value of vertex v is at
+     * position v * getStride( ).
+     */
+    inline const Scalar* getCoordinate( const unsigned int coordinate ) const
+    {
+        return _data.data( ) + coordinate;
+    };
+
+    inline size_t getStride( ) const
+    {
+        return _numberCoordinates;
+    };
+
+    inline unsigned int getNumberCoordinates( ) const
+    {
+        return _numberCoordinates;
+    };
+
+    /**
+     * Return the number of bytes reserved by the storage.
+     */
+    inline size_t getAllocatedBytes( ) const
+    {
+        return _data.capacity( ) * sizeof( Scalar );
+    };
+
+    /**
+     * Return the raw storage, with the attributes of each vertex contiguous.
+     */
+    inline Scalar* getData( ) const
+    {
+        return const_cast< Scalar* >( _data.data( ) );
+    };
+
+private:
+    std::vector< Scalar > _data;
+
+    unsigned int _numberCoordinates;
+};
+
+
+
+/**@class PlanarStorage
+ * Storage policy of the vertex attributes of a CornerTableT. Each attribute is
+ * stored on its own array (structure of arrays): xxx...yyy...zzz..., so loops
+ * over the vertices read unit stride arrays and can be vectorized. The arrays
+ * are blocks of the same buffer, getCapacity( ) values apart.
+ */
+template< typename Scalar >
+class PlanarStorage
+{
+public:
+    typedef Scalar ScalarType;
+
+    static const bool IS_INTERLEAVED = false;
+
+    PlanarStorage( ) : _numberCoordinates( 0 ), _capacity( 0 ) { };
+
+    /**
+     * Transpose an interleaved list.
+     * @param list - attributes of all vertices.
+     * @param numberCoordinates - number of attributes by vertex.
+     */
+    template< typename Source >
+    void assign( std::vector< Source >&& list, const unsigned int numberCoordinates )
+    {
+        assign( list.data( ), list.size( ) / numberCoordinates, numberCoordinates );
+    };
+
+    /**
+     * Transpose an interleaved list.
+     * @param list - attributes of all vertices.
+     * @param numberVertices - number of vertices on the list.
+     * @param numberCoordinates - number of attributes by vertex.
+     */
+    template< typename Source >
+    void assign( const Source* list, const size_t numberVertices, const unsigned int numberCoordinates )
+    {
+        _numberCoordinates = numberCoordinates;
+        _capacity = numberVertices;
+        _data.resize( numberCoordinates * numberVertices );
+
+        for (unsigned int coordinate = 0; coordinate < numberCoordinates; coordinate++)
+        {
+            Scalar* block = &_data[coordinate * _capacity];
+
+            for (size_t vertex = 0; vertex < numberVertices; vertex++)
+            {
+                block[vertex] = ( Scalar ) list[numberCoordinates * vertex + coordinate];
+            }
+        }
+    };
+
+    /**
+     * Change the number of vertices that can be stored, keeping the current
+     * attributes. The blocks are moved to their new positions.
+     * @param numberVertices - new capacity.
+     */
+    void resize( const size_t numberVertices )
+    {
+        std::vector< Scalar > data( _numberCoordinates * numberVertices );
+        size_t numberKept = std::min( numberVertices, _capacity );
+
+        for (unsigned int coordinate = 0; coordinate < _numberCoordinates; coordinate++)
+        {
+            std::copy( _data.begin( ) + coordinate * _capacity,
+                       _data.begin( ) + coordinate * _capacity + numberKept,
+                       data.begin( ) + coordinate * numberVertices );
+        }
+
+        _data.swap( data );
+        _capacity = numberVertices;
+    };
+
+    inline Scalar get( const size_t vertex, const unsigned int coordinate ) const
+    {
+        return _data[coordinate * _capacity + vertex];
+    };
+
+    inline void set( const size_t vertex, const unsigned int coordinate, const Scalar value )
+    {
+        _data[coordinate * _capacity + vertex] = value;
+    };
+
+    /**
+     * Return the array of a coordinate. Its values are contiguous.
+     */
+    inline const Scalar* getCoordinate( const unsigned int coordinate ) const
+    {
+        return _data.data( ) + coordinate * _capacity;
+    };
+
+    inline size_t getStride( ) const
+    {
+        return 1;
+    };
+
+    inline unsigned int getNumberCoordinates( ) const
+    {
+        return _numberCoordinates;
+    };
+
+    /**
+     * Return the number of bytes reserved by the storage.
+     */
+    inline size_t getAllocatedBytes( ) const
+    {
+        return _data.capacity( ) * sizeof( Scalar );
+    };
+
+    /**
+     * Return the number of vertices stored on each block.
+     */
+    inline size_t getCapacity( ) const
+    {
+        return _capacity;
+    };
+
+    /**
+     * Return the raw storage: one block of getCapacity( ) values by
+     * coordinate.
+     */
+    inline Scalar* getData( ) const
+    {
+        return const_cast< Scalar* >( _data.data( ) );
+    };
+
+private:
+    std::vector< Scalar > _data;
+
+    unsigned int _numberCoordinates;
+
+    size_t _capacity;
+};
+
+#endif /* VERTEXSTORAGE_H */
+
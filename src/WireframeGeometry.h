@@ -11,7 +11,7 @@
 #include <osg/Geometry>
 #include <memory>
 
-class CornerTable;
+#include "CornerTable.h"
 
 class WireframeGeometry : public osg::Geometry
 {